@@ -0,0 +1,443 @@
+/* #############################################################
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * #############################################################
+ *
+ * microbench.c
+ *
+ * 	This file contains the microbenchmarks for the hot paths
+ *  of the solver. Every kernel runs on synthetic formulas
+ *  with a controlled size, clause length and occurrence
+ *  skew. The time per operation, the operations per second
+ *  and (if perf_event_open() is available) the cache misses
+ *  per operation are reported and compared against a
+ *  baseline file.
+ *
+ *  Usage: microbench [-b <baseline file>] [-t <threshold>]
+ *                    [-w <baseline file>]
+ *  -b compares against the baseline file, a kernel which is
+ *  more then <threshold> percent slower is a regression and
+ *  the exit status is EXIT_FAILURE. -w writes the results
+ *  as a new baseline file. The baseline file starts with
+ *  the compiler and the flags of its measurement ("# cc"
+ *  and "# cflags" lines), a comparison with other flags is
+ *  reported.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "../src/solver.h"
+
+
+#define MICROBENCH_SEED 1					/* The random seed of the formulas and the kernels. */
+#define MICROBENCH_MIN_TIME 200000000LL		/* The minimum run time of a kernel in nanoseconds. */
+#define MICROBENCH_THRESHOLD 10				/* The default regression threshold in percent. */
+#define MICROBENCH_NAME_MAXLENGTH 63		/* The maximum length of a "formula/kernel" name. */
+#define MICROBENCH_BASELINE_MAX 64			/* The maximum number of entries in the baseline file. */
+#define MICROBENCH_LINE_MAXLENGTH 255		/* The maximum length of a line of the baseline file. */
+
+#ifndef MICROBENCH_CC
+#define MICROBENCH_CC "unknown"				/* The compiler of this build (set by the Makefile). */
+#endif
+
+#ifndef MICROBENCH_CFLAGS
+#define MICROBENCH_CFLAGS "unknown"			/* The flags of this build (set by the Makefile). */
+#endif
+
+
+/* The synthetic formulas. A clause length of 0 means a
+ * random length from 2 to 6 (the generic path without the
+ * k-SAT kernels). The skew is the exponent of the
+ * occurrence distribution: 0 is uniform, with a higher
+ * skew the variables with low numbers occur more often. */
+struct {
+	char *name;
+	unsigned int numVars;
+	unsigned int clauseLength;
+	double ratio;
+	double skew;
+} microbenchFormulas[] = {
+	{ "3sat",         20000, 3,  4.2, 0.0 },
+	{ "3sat-skew",    20000, 3,  4.2, 2.0 },
+	{ "5sat",          5000, 5, 20.0, 0.0 },
+	{ "mixed",         5000, 0,  5.0, 0.0 },
+	{ "3sat-large", 1000000, 3,  4.2, 0.0 }
+};
+
+
+/* The kernels. */
+char *microbenchKernels[] = {
+	"updateClauseStatusList",
+	"updateVarScoreList",
+	"rotsGetFlippedVariables",
+	"ilssaSimulatedAnnealing",
+	"flip"
+};
+
+
+/* External variables for the formula of the current
+ * benchmark (see solver() for the description). */
+int **clauseList;
+int **varList;
+int *varScoreList;
+int *clauseStatusList;
+unsigned short *solution;
+int *flippedVariables;
+
+
+/* External variable for the file descriptor of the cache
+ * miss counter (-1 if perf_event_open() is not
+ * available). */
+int microbenchPerfFd = -1;
+
+
+/* External variables for the baseline file. */
+char microbenchBaselineNames[MICROBENCH_BASELINE_MAX][MICROBENCH_NAME_MAXLENGTH + 1];
+double microbenchBaselineValues[MICROBENCH_BASELINE_MAX];
+unsigned int microbenchBaselineCount = 0;
+
+
+/* microbenchTime()
+ *
+ * Returns the monotonic time in nanoseconds. */
+long long microbenchTime() {
+	struct timespec now;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+
+/* microbenchPerfOpen()
+ *
+ * Opens the cache miss counter of this process. */
+void microbenchPerfOpen() {
+	struct perf_event_attr attr;
+
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	microbenchPerfFd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+	if (microbenchPerfFd < 0)
+		printf("c perf_event_open() is not available, no cache misses are counted.\n");
+}
+
+
+/* microbenchRandomVar()
+ *
+ * Returns a random variable of the skewed occurrence
+ * distribution. */
+unsigned int microbenchRandomVar(unsigned int numVars, double skew) {
+	double random = (double)rand() / ((double)RAND_MAX + 1.0);
+
+
+	return (unsigned int)(numVars * pow(random, 1.0 + skew)) + 1;
+}
+
+
+/* microbenchGenerateFormula()
+ *
+ * Generates a random formula with the api of the
+ * incremental solving and a random solution candidate. */
+void microbenchGenerateFormula(unsigned int numVars, unsigned int clauseLength, double ratio, double skew) {
+	unsigned int numClauses = (unsigned int)(numVars * ratio);	/* Number of clauses. */
+	unsigned int iClauses;										/* Loop variable for the clauses. */
+	unsigned int iLiterals;										/* Loop variable for the literals. */
+	unsigned int iVars;											/* Loop variable for the variables. */
+	int literals[8];											/* The literals of the new clause. */
+	unsigned int var;											/* The variable of the new literal. */
+	bool duplicate;												/* Is the variable already in the clause? */
+
+
+	initialiseFormula(&clauseList, &varList, &varScoreList, &solution, &clauseStatusList, &flippedVariables);
+	addVariables(numVars, &varList, &varScoreList, &solution, &flippedVariables);
+
+	for (iVars = 1; iVars <= numVars; iVars++)
+		solution[iVars] = rand() % 2;
+
+	for (iClauses = 0; iClauses < numClauses; iClauses++) {
+		literals[0] = (clauseLength > 0 ? clauseLength : (rand() % 5) + 2);
+
+		for (iLiterals = 1; iLiterals <= literals[0]; iLiterals++) {
+			do {
+				var = microbenchRandomVar(numVars, skew);
+
+				for (duplicate = false, iVars = 1; iVars < iLiterals; iVars++)
+					duplicate = duplicate || (abs(literals[iVars]) == var);
+			} while (duplicate == true);
+
+			literals[iLiterals] = (rand() % 2 == 0 ? (int)var : (int)var * -1);
+		}
+
+		addClause(literals, &clauseList, &varList, &solution, &clauseStatusList);
+	}
+
+	rebuildClauseStatusList(&solution, &clauseList, &clauseStatusList);
+	updateVarScoreList(&solution, &varList, &varScoreList, &clauseStatusList);
+}
+
+
+/* microbenchRunKernel()
+ *
+ * Runs one operation of the kernel. */
+void microbenchRunKernel(unsigned int kernel, unsigned int iteration) {
+	unsigned int iFlippedVariables;	/* Loop variable for the flippedVariables. */
+
+
+	switch (kernel) {
+		case 0:	/* A random flip */
+			flippedVariables[0] = 1;
+			flippedVariables[1] = rand() % varList[0][0] + 1;
+			solution[flippedVariables[1]] = 1 - solution[flippedVariables[1]];
+			updateClauseStatusList(&flippedVariables, &solution, &varList, &clauseStatusList);
+			break;
+		case 1:
+			updateVarScoreList(&solution, &varList, &varScoreList, &clauseStatusList);
+			break;
+		case 2:
+			rotsGetFlippedVariables(&flippedVariables, iteration, &solution, &varList, &varScoreList, &clauseStatusList);
+			break;
+		case 3:	/* With the maximum temperature */
+			flippedVariables[0] = 0;
+
+			ilssaSimulatedAnnealing(&flippedVariables, 0, &varList, &varScoreList, &clauseStatusList);
+			break;
+		case 4:	/* A RoTS step like in solverSearch() */
+			flippedVariables[0] = 0;
+
+			if (rotsGetFlippedVariables(&flippedVariables, iteration, &solution, &varList, &varScoreList, &clauseStatusList) == 1) {
+				for (iFlippedVariables = 1; iFlippedVariables <= flippedVariables[0]; iFlippedVariables++)
+					solution[flippedVariables[iFlippedVariables]] = 1 - solution[flippedVariables[iFlippedVariables]];
+
+				updateClauseStatusList(&flippedVariables, &solution, &varList, &clauseStatusList);
+
+				if (ksatLength == 0)
+					updateVarScoreList(&solution, &varList, &varScoreList, &clauseStatusList);
+			}
+			break;
+	}
+}
+
+
+/* microbenchBaseline()
+ *
+ * Returns the time per operation of the name in the
+ * baseline file or 0 if it isn't there. */
+double microbenchBaseline(char name[]) {
+	unsigned int iBaseline;	/* Loop variable for the baseline entries. */
+
+
+	for (iBaseline = 0; iBaseline < microbenchBaselineCount; iBaseline++) {
+		if (strcmp(microbenchBaselineNames[iBaseline], name) == 0)
+			return microbenchBaselineValues[iBaseline];
+	}
+
+	return 0;
+}
+
+
+/* microbenchReadBaseline()
+ *
+ * Reads the baseline file with one "formula/kernel ns/op"
+ * line for each benchmark and notes, if it was measured
+ * with other flags than this build. */
+void microbenchReadBaseline(char baselineFilePath[]) {
+	FILE *baselineFileHandle;					/* File handle for the baseline file. */
+	char line[MICROBENCH_LINE_MAXLENGTH + 1];	/* Current line of the baseline file. */
+
+
+	baselineFileHandle = fopen(baselineFilePath, "r");
+	if (baselineFileHandle == NULL)
+		pExit("The baseline file \"%s\" can't be read: %s (see \"make microbench-baseline\")\n", baselineFilePath, strerror(errno));
+
+	while (microbenchBaselineCount < MICROBENCH_BASELINE_MAX && fgets(line, sizeof(line), baselineFileHandle) != NULL) {
+		line[strcspn(line, "\n")] = '\0';
+
+		if (strncmp(line, "# cflags ", 9) == 0) {
+			if (strcmp(&line[9], MICROBENCH_CFLAGS) != 0)
+				printf("c The baseline was measured with the flags \"%s\", this build uses \"%s\".\n", &line[9], MICROBENCH_CFLAGS);
+		} else if (line[0] != '#' && sscanf(line, "%63s %lf", microbenchBaselineNames[microbenchBaselineCount], &microbenchBaselineValues[microbenchBaselineCount]) == 2) {
+			microbenchBaselineCount++;
+		}
+	}
+
+	fclose(baselineFileHandle);
+
+	if (microbenchBaselineCount == 0)
+		pExit("The baseline file \"%s\" has no entries!\n", baselineFilePath);
+}
+
+
+/* main()
+ *
+ * Runs every kernel on every formula and prints the
+ * results. */
+int main(int argc, char* argv[]) {
+	char *baselineFilePath = NULL;		/* The baseline file to compare with. */
+	char *newBaselineFilePath = NULL;	/* The baseline file to write. */
+	double threshold = MICROBENCH_THRESHOLD;	/* The regression threshold in percent. */
+	FILE *newBaselineFileHandle = NULL;	/* File handle for the new baseline file. */
+	unsigned int regressions = 0;		/* Number of regressions. */
+
+	unsigned int iArgc;			/* Loop variable for the arguments. */
+	unsigned int iFormulas;		/* Loop variable for the formulas. */
+	unsigned int iKernels;		/* Loop variable for the kernels. */
+	unsigned int iOperations;	/* Loop variable for the operations of a batch. */
+
+	char name[MICROBENCH_NAME_MAXLENGTH + 1];	/* "formula/kernel" */
+	unsigned long long operations;				/* Number of operations. */
+	unsigned int batch;							/* Number of operations between two time measurements. */
+	long long startTime;						/* Start time of the kernel. */
+	long long elapsedTime;						/* Run time of the kernel. */
+	uint64_t cacheMisses;						/* Cache misses of the kernel. */
+	double nsPerOp;								/* Nanoseconds per operation. */
+	double baseline;							/* Nanoseconds per operation of the baseline. */
+	char comparison[32];						/* The change against the baseline. */
+	char cacheMissesPerOp[32];					/* The cache misses per operation. */
+
+
+	for (iArgc = 1; iArgc < argc; iArgc++) {
+		if (strcmp(argv[iArgc], "-b") == 0 && iArgc + 1 < argc)
+			baselineFilePath = argv[++iArgc];
+		else if (strcmp(argv[iArgc], "-w") == 0 && iArgc + 1 < argc)
+			newBaselineFilePath = argv[++iArgc];
+		else if (strcmp(argv[iArgc], "-t") == 0 && iArgc + 1 < argc)
+			threshold = atof(argv[++iArgc]);
+		else
+			pExit("Usage: %s [-b <baseline file>] [-t <threshold in percent>] [-w <baseline file>]\n", argv[0]);
+	}
+
+	if (baselineFilePath != NULL)
+		microbenchReadBaseline(baselineFilePath);
+
+	if (newBaselineFilePath != NULL) {
+		newBaselineFileHandle = fopen(newBaselineFilePath, "w");
+		if (newBaselineFileHandle == NULL)
+			pExit("The baseline file \"%s\" can't be written!\n", newBaselineFilePath);
+
+		fprintf(newBaselineFileHandle, "# cc %s %s\n# cflags %s\n", MICROBENCH_CC, __VERSION__, MICROBENCH_CFLAGS);
+	}
+
+	microbenchPerfOpen();
+
+	printf("%-40s %12s %14s %16s %10s\n", "formula/kernel", "ns/op", "ops/sec", "cache-misses/op", "baseline");
+
+
+	for (iFormulas = 0; iFormulas < sizeof(microbenchFormulas) / sizeof(microbenchFormulas[0]); iFormulas++) {
+		srand(MICROBENCH_SEED);
+
+		microbenchGenerateFormula(microbenchFormulas[iFormulas].numVars, microbenchFormulas[iFormulas].clauseLength, microbenchFormulas[iFormulas].ratio, microbenchFormulas[iFormulas].skew);
+
+		rotsInitialisation(&varList);
+		ilssaInitialisation(&varList);
+		assignmentInitialisation(&varList);
+		ksatInitialisation(&clauseList, &varList, &varScoreList);
+
+		for (iKernels = 0; iKernels < sizeof(microbenchKernels) / sizeof(microbenchKernels[0]); iKernels++) {
+			snprintf(name, sizeof(name), "%s/%s", microbenchFormulas[iFormulas].name, microbenchKernels[iKernels]);
+
+			/* Warm up and calibrate the batch size to about 1 ms */
+			startTime = microbenchTime();
+			for (batch = 0; batch < 1000000 && microbenchTime() - startTime < 1000000; batch++)
+				microbenchRunKernel(iKernels, batch);
+			batch = (batch > 0 ? batch : 1);
+
+			if (microbenchPerfFd >= 0) {
+				ioctl(microbenchPerfFd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(microbenchPerfFd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+
+			operations = 0;
+			startTime = microbenchTime();
+
+			do {
+				for (iOperations = 0; iOperations < batch; iOperations++)
+					microbenchRunKernel(iKernels, operations + iOperations);
+
+				operations = operations + batch;
+				elapsedTime = microbenchTime() - startTime;
+			} while (elapsedTime < MICROBENCH_MIN_TIME);
+
+			strcpy(cacheMissesPerOp, "n/a");
+
+			if (microbenchPerfFd >= 0) {
+				ioctl(microbenchPerfFd, PERF_EVENT_IOC_DISABLE, 0);
+
+				if (read(microbenchPerfFd, &cacheMisses, sizeof(cacheMisses)) == sizeof(cacheMisses))
+					snprintf(cacheMissesPerOp, sizeof(cacheMissesPerOp), "%.2f", (double)cacheMisses / operations);
+			}
+
+
+			/* Result */
+			nsPerOp = (double)elapsedTime / operations;
+			baseline = microbenchBaseline(name);
+
+			if (baseline > 0) {
+				snprintf(comparison, sizeof(comparison), "%+.1f%%", (nsPerOp / baseline - 1.0) * 100.0);
+
+				if (nsPerOp > baseline * (1.0 + threshold / 100.0)) {
+					strcat(comparison, " REGRESSION");
+					regressions++;
+				}
+			} else {
+				strcpy(comparison, "-");
+			}
+
+			printf("%-40s %12.1f %14.0f %16s %10s\n", name, nsPerOp, 1000000000.0 / nsPerOp, cacheMissesPerOp, comparison);
+			fflush(stdout);
+
+			if (newBaselineFileHandle != NULL)
+				fprintf(newBaselineFileHandle, "%s %.1f\n", name, nsPerOp);
+		}
+
+		rotsCleanUp();
+		ilssaCleanUp();
+		assignmentCleanUp();
+		ksatCleanUp();
+		solverCleanUp(&clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables);
+		free(solution);
+	}
+
+
+	if (newBaselineFileHandle != NULL)
+		fclose(newBaselineFileHandle);
+
+	if (microbenchPerfFd >= 0)
+		close(microbenchPerfFd);
+
+	if (regressions > 0) {
+		printf("%u regressions over the threshold of %.1f%%.\n", regressions, threshold);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
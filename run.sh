@@ -7,8 +7,12 @@ if [ $# == 3 ]; then
 		if [ "$2" == "2" ]; then
 			ALGORITHM="ilssa"
 		else
-			echo "The algorithm parameter must be 1 (RoTS) or 2 (ILS/SA)!"
-			exit 1
+			if [ "$2" == "3" ]; then
+				ALGORITHM="auto"
+			else
+				echo "The algorithm parameter must be 1 (RoTS), 2 (ILS/SA) or 3 (automatic selection)!"
+				exit 1
+			fi
 		fi
 	fi
 	
@@ -19,5 +23,5 @@ if [ $# == 3 ]; then
 		echo "pSAT binary not found. Compile first?"
 	fi
 else
-	echo "There must be 3 parameters: \"instance file path\" \"algorithm (1 [RoTS] or 2 [ILS/SA]).\" \"random seed\""
+	echo "There must be 3 parameters: \"instance file path\" \"algorithm (1 [RoTS], 2 [ILS/SA] or 3 [auto]).\" \"random seed\""
 fi
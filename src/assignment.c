@@ -0,0 +1,466 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * assignment.c
+ *	
+ * 	This file contains the constructions of the initial
+ *  solution candidate for each restart.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "assignment.h"
+
+
+/* External variable for the name of the initial
+ * assignment construction. Currently implemented are:
+ * - "random": every variable is assigned randomly,
+ * - "polarity": every variable is assigned to the value
+ *   of the majority of its occurrences,
+ * - "propagation": a greedy assignment with unit
+ *   propagation,
+ * - "hints": the variables are assigned to the values
+ *   given by the phase hints file and
+ * - "best": the best solution candidate so far with a
+ *   partial randomisation. */
+char assignmentName[ASSIGNMENT_NAME_MAXLENGTH + 1] = "random";
+
+/* External variable for the path to the phase hints
+ * file. It contains literals in the format of the
+ * "v" lines of the solution output. */
+char assignmentHintsFilePath[ASSIGNMENT_HINTSFILE_PATH_MAXLENGTH + 1] = "";
+
+
+/* External variable for the phase hints.
+ * It contains for each variable 0 if there is no
+ * hint or the hinted value + 1. */
+unsigned short *assignmentHints = NULL;
+
+
+/* External variable for the best solution candidate
+ * so far and its number of unsatisfied clauses. The
+ * index 0 (assignmentBestSolution[0]) contains the
+ * number of variables. */
+unsigned short *assignmentBestSolution = NULL;
+int assignmentBestQuality = INT_MAX;
+
+
+/* External variables for the lazy copy of the best
+ * solution candidate. If assignmentBestInTry is true,
+ * the best solution candidate was reached in the current
+ * try and assignmentBestSolution is outdated. Then it is
+ * the current solution candidate, but the variables of
+ * assignmentBestChanged have the values of
+ * assignmentBestValues. assignmentBestValues contains for
+ * each variable 0 if it wasn't changed since the best
+ * solution candidate or its value in the best solution
+ * candidate + 1. The index 0 (assignmentBestChanged[0])
+ * is the number of changed variables. */
+bool assignmentBestInTry = false;
+unsigned int *assignmentBestChanged = NULL;
+unsigned short *assignmentBestValues = NULL;
+
+
+/* assignmentIsKnown()
+ *
+ * Returns true if an initial assignment construction with
+ * this name exists. */
+bool assignmentIsKnown(char name[]) {
+	return (strcmp(name, "random") == 0 || strcmp(name, "polarity") == 0 || strcmp(name, "propagation") == 0
+			|| strcmp(name, "hints") == 0 || strcmp(name, "best") == 0);
+}
+
+
+/* assignmentReadHintsFile()
+ *
+ * Reads the phase hints file into assignmentHints. Lines
+ * starting with "c" or "s" are ignored, a leading "v" is
+ * skipped. */
+void assignmentReadHintsFile(int ***varList) {
+	FILE *hintsFileHandle;	/* File handle for the phase hints file. */
+	int curChar;			/* Current character of the phase hints file. */
+	int litTmp;				/* Temporal variable for one literal. */
+	unsigned int var;		/* Variable of litTmp. */
+
+
+	assignmentHints = calloc(((*varList)[0][0] + 1), sizeof(unsigned short));
+	if (assignmentHints == NULL)
+		perror("calloc() for assignmentHints failed");
+
+	hintsFileHandle = fopen(assignmentHintsFilePath, "r");
+
+	if (hintsFileHandle == NULL)
+		pExit("Can't open phase hints file!\n");
+
+	while ((curChar = fgetc(hintsFileHandle)) != EOF) {
+		if (curChar == 'c' || curChar == 's') {
+			while (curChar != '\n' && curChar != EOF)
+				curChar = fgetc(hintsFileHandle);
+		} else if (curChar == '-' || (curChar >= '0' && curChar <= '9')) {
+			ungetc(curChar, hintsFileHandle);
+
+			if (fscanf(hintsFileHandle, "%d", &litTmp) != 1)
+				pExit("Can't read a literal from the phase hints file!\n");
+
+			var = (litTmp > 0 ? litTmp : (litTmp * -1));
+
+			if (var > (*varList)[0][0])
+				pExit("The variable %d in the phase hints file is out of range of %d!\n", litTmp, (*varList)[0][0]);
+
+			if (litTmp != 0)
+				assignmentHints[reorderVariable(var)] = (litTmp > 0 ? 2 : 1);	/* The hints are given in the original numbering. */
+		}
+	}
+
+	fclose(hintsFileHandle);
+}
+
+
+/* assignmentInitialisation()
+ * 
+ * Initialisation of the initial assignment construction
+ * for a new search. */
+void assignmentInitialisation(int ***varList) {
+	assignmentBestSolution = calloc(((*varList)[0][0] + 1), sizeof(unsigned short));
+	if (assignmentBestSolution == NULL)
+		perror("calloc() for assignmentBestSolution failed");
+
+	assignmentBestSolution[0] = (*varList)[0][0];
+	assignmentBestQuality = INT_MAX;
+
+	assignmentBestChanged = calloc(((*varList)[0][0] + 1), sizeof(unsigned int));
+	if (assignmentBestChanged == NULL)
+		perror("calloc() for assignmentBestChanged failed");
+
+	assignmentBestValues = calloc(((*varList)[0][0] + 1), sizeof(unsigned short));
+	if (assignmentBestValues == NULL)
+		perror("calloc() for assignmentBestValues failed");
+
+	assignmentBestInTry = false;
+
+	if (strcmp(assignmentName, "hints") == 0)
+		assignmentReadHintsFile(&(*varList));
+}
+
+
+/* assignmentClearBestChanged()
+ *
+ * Empties the list of the variables changed since the
+ * best solution candidate. */
+void assignmentClearBestChanged() {
+	unsigned int iBestChanged;	/* Loop variable for the assignmentBestChanged. */
+
+
+	for (iBestChanged = 1; iBestChanged <= assignmentBestChanged[0]; iBestChanged++)
+		assignmentBestValues[assignmentBestChanged[iBestChanged]] = 0;
+
+	assignmentBestChanged[0] = 0;
+}
+
+
+/* assignmentUpdateBest()
+ *
+ * Notes the solution candidate, if it is better then the
+ * best solution candidate so far. Instead of copying every
+ * improvement, only the variables changed since are
+ * recorded (see assignmentNoteFlip()). */
+void assignmentUpdateBest(unsigned short **solution, int ***varList, int **clauseStatusList) {
+	if ((*clauseStatusList)[0] < assignmentBestQuality) {
+		assignmentBestQuality = (*clauseStatusList)[0];
+		assignmentBestInTry = true;
+
+		assignmentClearBestChanged();
+	}
+}
+
+
+/* assignmentNoteFlip()
+ *
+ * Records the value of the variable before it is flipped
+ * in the solution candidate. */
+void assignmentNoteFlip(unsigned int var, unsigned short **solution) {
+	if (assignmentBestInTry == true && assignmentBestValues[var] == 0) {
+		assignmentBestValues[var] = (*solution)[var] + 1;
+
+		assignmentBestChanged[0] = assignmentBestChanged[0] + 1;
+		assignmentBestChanged[assignmentBestChanged[0]] = var;
+	}
+}
+
+
+/* assignmentSyncBest()
+ *
+ * Brings assignmentBestSolution up to date. This must be
+ * called before the solution candidate is replaced. */
+void assignmentSyncBest(unsigned short **solution, int ***varList) {
+	unsigned int iBestChanged;	/* Loop variable for the assignmentBestChanged. */
+	unsigned int var;			/* Changed variable. */
+
+
+	if (assignmentBestInTry == false)
+		return;
+
+	memcpy(&assignmentBestSolution[1], &(*solution)[1], (*varList)[0][0] * sizeof(unsigned short));
+
+	for (iBestChanged = 1; iBestChanged <= assignmentBestChanged[0]; iBestChanged++) {
+		var = assignmentBestChanged[iBestChanged];
+
+		assignmentBestSolution[var] = assignmentBestValues[var] - 1;
+	}
+
+	assignmentClearBestChanged();
+
+	assignmentBestInTry = false;
+}
+
+
+/* assignmentNoise()
+ *
+ * Returns the value or, after the first try and with the
+ * probability ASSIGNMENT_NOISE, a random value. */
+unsigned short assignmentNoise(unsigned short value, unsigned int restartsCount) {
+	if (restartsCount > 0 && rand() < (ASSIGNMENT_NOISE * RAND_MAX))
+		return rand() % 2;
+
+	return value;
+}
+
+
+/* assignmentMajority()
+ *
+ * Returns the value of the majority of the occurrences of
+ * the variable. Ties are broken randomly. */
+unsigned short assignmentMajority(unsigned int var, int ***varList) {
+	unsigned int iVarListClause;	/* Loop variable for the clauses of this variable. */
+	int balance = 0;				/* Number of positive minus number of negative occurrences. */
+
+
+	for (iVarListClause = 1; iVarListClause <= (*varList)[var][0]; iVarListClause++)
+		balance = balance + ((*varList)[var][iVarListClause] > 0 ? 1 : -1);
+
+	if (balance == 0)
+		return rand() % 2;
+
+	return (balance > 0 ? 1 : 0);
+}
+
+
+/* assignmentPropagate()
+ *
+ * Assigns the variable and propagates all resulting unit
+ * clauses for assignmentPropagation(). A clause whose
+ * literals are all false is skipped, the local search has
+ * to repair it. Fixed variables are never assigned by the
+ * propagation: a unit clause whose last literal is a false
+ * fixed variable is such a conflict. */
+void assignmentPropagate(unsigned int var, unsigned short value, unsigned short **solution, int ***clauseList, int ***varList, unsigned short *assigned, int *unassignedLiterals, int *unitClauses) {
+	unsigned int iVarListClause;	/* Loop variable for the clauses of a variable. */
+	unsigned int iClauseListLit;	/* Loop variable for the literals of a unit clause. */
+	int curClause;					/* Current selected clause. */
+	int curLiteral;					/* Current selected literal. */
+
+
+	unitClauses[0] = 0;
+
+	while (true) {
+		if (assigned[var] != 1) {
+			assigned[var] = 1;
+			(*solution)[var] = value;
+
+			for (iVarListClause = 1; iVarListClause <= (*varList)[var][0]; iVarListClause++) {	/* Loop over every clause which contains this variable. */
+				curClause = (*varList)[var][iVarListClause];
+
+				if (unassignedLiterals[(curClause > 0 ? curClause : (curClause * -1))] < 0)
+					continue; /* This clause is already satisfied. */
+
+				if ((curClause > 0 && value == 1) || (curClause < 0 && value == 0)) {
+					unassignedLiterals[(curClause > 0 ? curClause : (curClause * -1))] = -1;
+				} else {
+					curClause = (curClause > 0 ? curClause : (curClause * -1));
+					unassignedLiterals[curClause] = unassignedLiterals[curClause] - 1;
+
+					if (unassignedLiterals[curClause] == 1) {
+						unitClauses[0] = unitClauses[0] + 1;
+						unitClauses[unitClauses[0]] = curClause;
+					}
+				}
+			}
+		}
+
+		/* Select the next unit clause */
+		var = 0;
+
+		while (unitClauses[0] > 0 && var == 0) {
+			curClause = unitClauses[unitClauses[0]];
+			unitClauses[0] = unitClauses[0] - 1;
+
+			if (unassignedLiterals[curClause] != 1)
+				continue; /* The clause is satisfied or all literals are false. */
+
+			for (iClauseListLit = 1; iClauseListLit <= (*clauseList)[curClause][0]; iClauseListLit++) {
+				curLiteral = (*clauseList)[curClause][iClauseListLit];
+
+				if (assigned[(curLiteral > 0 ? curLiteral : (curLiteral * -1))] == 0) {
+					var = (curLiteral > 0 ? curLiteral : (curLiteral * -1));
+					value = (curLiteral > 0 ? 1 : 0);
+					break;
+				}
+			}
+		}
+
+		if (var == 0)
+			break; /* Nothing left to propagate */
+	}
+}
+
+
+/* assignmentPropagation()
+ *
+ * Greedy assignment with unit propagation: The fixed
+ * variables are assigned first, all of them before the
+ * propagation of the first one. Then every unassigned
+ * variable is assigned to the value of the majority of its
+ * occurrences and the unit clauses are propagated. */
+void assignmentPropagation(unsigned int restartsCount, unsigned short **solution, int ***clauseList, int ***varList) {
+	unsigned int iVarList;		/* Loop variable for the varList. */
+	unsigned int iClauseList;	/* Loop variable for the clauseList. */
+	int curLiteral;				/* Literal of the current unit clause. */
+
+	/* For each variable 1 if it is already assigned and its
+	 * clauses are updated, 2 if it is fixed and its clauses
+	 * are not updated yet. */
+	unsigned short *assigned;
+
+	/* For each clause the number of unassigned literals or
+	 * -1 if the clause is satisfied. */
+	int *unassignedLiterals;
+
+	/* Stack of clauses with one unassigned literal. The
+	 * index 0 is the number of clauses on the stack. */
+	int *unitClauses;
+
+
+	assigned = calloc(((*varList)[0][0] + 1), sizeof(unsigned short));
+	unassignedLiterals = malloc(((*clauseList)[0][0] + 1) * sizeof(int));
+	unitClauses = malloc(((*clauseList)[0][0] + 1) * sizeof(int));
+	if (assigned == NULL || unassignedLiterals == NULL || unitClauses == NULL)
+		perror("malloc() for assignmentPropagation() failed");
+
+	unitClauses[0] = 0;
+
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++)
+		unassignedLiterals[iClauseList] = (*clauseList)[iClauseList][0];
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {	/* Fixed variables first */
+		if (fixedVariables[iVarList] != 0) {
+			assigned[iVarList] = 2;
+			(*solution)[iVarList] = fixedVariables[iVarList] - 1;
+		}
+	}
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {
+		if (fixedVariables[iVarList] != 0)
+			assignmentPropagate(iVarList, fixedVariables[iVarList] - 1, &(*solution), &(*clauseList), &(*varList), assigned, unassignedLiterals, unitClauses);
+	}
+
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++) {	/* Unit clauses of the formula */
+		if ((*clauseList)[iClauseList][0] == 1 && unassignedLiterals[iClauseList] == 1) {
+			curLiteral = (*clauseList)[iClauseList][1];
+			assignmentPropagate((curLiteral > 0 ? curLiteral : (curLiteral * -1)), (curLiteral > 0 ? 1 : 0), &(*solution), &(*clauseList), &(*varList), assigned, unassignedLiterals, unitClauses);
+		}
+	}
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {	/* Decisions */
+		if (assigned[iVarList] == 0)
+			assignmentPropagate(iVarList, assignmentNoise(assignmentMajority(iVarList, &(*varList)), restartsCount), &(*solution), &(*clauseList), &(*varList), assigned, unassignedLiterals, unitClauses);
+	}
+
+	free(assigned);
+	free(unassignedLiterals);
+	free(unitClauses);
+}
+
+
+/* assignmentGenerate()
+ * 
+ * Generates the initial solution candidate for the
+ * restart with the construction selected by
+ * assignmentName. Fixed variables always get their fixed
+ * value. */
+void assignmentGenerate(unsigned int restartsCount, unsigned short **solution, int ***clauseList, int ***varList) {
+	unsigned int iVarList;	/* Loop variable for the varList. */
+
+	bool usePolarity = (strcmp(assignmentName, "polarity") == 0);								/* Majority of the occurrences? */
+	bool useHints = (strcmp(assignmentName, "hints") == 0);										/* Phase hints? */
+	bool useBest = (strcmp(assignmentName, "best") == 0 && assignmentBestQuality < INT_MAX);	/* Best solution candidate so far? */
+
+
+	if (strcmp(assignmentName, "propagation") == 0) {
+		assignmentPropagation(restartsCount, &(*solution), &(*clauseList), &(*varList));
+		return;
+	}
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {
+		if (fixedVariables[iVarList] != 0)
+			(*solution)[iVarList] = fixedVariables[iVarList] - 1;
+		else if (usePolarity == true)
+			(*solution)[iVarList] = assignmentNoise(assignmentMajority(iVarList, &(*varList)), restartsCount);
+		else if (useHints == true && assignmentHints[iVarList] != 0)
+			(*solution)[iVarList] = assignmentNoise(assignmentHints[iVarList] - 1, restartsCount);
+		else if (useBest == true)
+			(*solution)[iVarList] = assignmentNoise(assignmentBestSolution[iVarList], restartsCount);
+		else
+			(*solution)[iVarList] = rand() % 2;
+	}
+}
+
+
+/* assignmentCleanUp()
+ *
+ * Deallocate memory which was used by the initial
+ * assignment construction. */
+void assignmentCleanUp() {
+	free(assignmentBestSolution);
+	assignmentBestSolution = NULL;
+
+	free(assignmentBestChanged);
+	assignmentBestChanged = NULL;
+
+	free(assignmentBestValues);
+	assignmentBestValues = NULL;
+
+	free(assignmentHints);
+	assignmentHints = NULL;
+}
+
+
+/* assignmentWriteCheckpoint()
+ *
+ * Writes the best solution candidate so far into the
+ * checkpoint file. */
+void assignmentWriteCheckpoint(FILE *checkpointFileHandle, unsigned short **solution, int ***varList) {
+	assignmentSyncBest(&(*solution), &(*varList));
+
+	checkpointWriteData(&assignmentBestQuality, sizeof(assignmentBestQuality), checkpointFileHandle);
+	checkpointWriteValues(assignmentBestSolution, (*varList)[0][0], checkpointFileHandle);
+}
+
+
+/* assignmentReadCheckpoint()
+ *
+ * Reads the best solution candidate so far from the
+ * checkpoint file. */
+void assignmentReadCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointReadData(&assignmentBestQuality, sizeof(assignmentBestQuality), checkpointFileHandle);
+	checkpointReadValues(assignmentBestSolution, (*varList)[0][0], checkpointFileHandle);
+}
@@ -0,0 +1,72 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * assignment.h
+ *
+ *    This is the header file for assignment.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef ASSIGNMENT_H
+#define ASSIGNMENT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "solver.h"
+
+
+#define ASSIGNMENT_NAME_MAXLENGTH 15		/* The maximum length of the initial assignment name. */
+#define ASSIGNMENT_HINTSFILE_PATH_MAXLENGTH 255	/* The maximum length of the phase hints file path. */
+
+/* The probability that a variable gets a random value
+ * instead of the value of the initial assignment
+ * construction. It is used for all restarts after the
+ * first one, so the restarts don't start from the same
+ * solution candidate. */
+#define ASSIGNMENT_NOISE 0.1
+
+
+extern char assignmentName[ASSIGNMENT_NAME_MAXLENGTH + 1];
+
+extern char assignmentHintsFilePath[ASSIGNMENT_HINTSFILE_PATH_MAXLENGTH + 1];
+
+extern unsigned short *assignmentBestSolution;
+
+extern int assignmentBestQuality;
+
+
+bool assignmentIsKnown(char name[]);
+
+void assignmentInitialisation(int ***varList);
+
+void assignmentUpdateBest(unsigned short **solution, int ***varList, int **clauseStatusList);
+
+void assignmentNoteFlip(unsigned int var, unsigned short **solution);
+
+void assignmentSyncBest(unsigned short **solution, int ***varList);
+
+void assignmentGenerate(unsigned int restartsCount, unsigned short **solution, int ***clauseList, int ***varList);
+
+void assignmentWriteCheckpoint(FILE *checkpointFileHandle, unsigned short **solution, int ***varList);
+
+void assignmentReadCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
+void assignmentCleanUp();
+
+
+#endif /* ASSIGNMENT_H */
\ No newline at end of file
@@ -0,0 +1,384 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * checkpoint.c
+ *	
+ * 	This file contains the checkpoints of the search state.
+ *  A checkpoint is written periodically, on SIGUSR1 and on
+ *  SIGTERM into a binary file (in the byte order of the
+ *  machine), so the search can be resumed exactly where it
+ *  was left. The clauseStatusList and the weighted scores
+ *  are not stored, they are rebuilt from the solution
+ *  candidate.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "checkpoint.h"
+
+
+/* External variables for the checkpoint file path (empty
+ * if no checkpoints are written), the number of seconds
+ * between two periodic checkpoints (0 = only on signals)
+ * and if the search resumes from the checkpoint file. */
+char checkpointFilePath[CHECKPOINT_FILE_PATH_MAXLENGTH + 1] = "";
+unsigned int checkpointInterval = CHECKPOINT_INTERVAL;
+bool checkpointResume = false;
+
+
+/* External variable for the request of the signal handler
+ * (see CHECKPOINT_REQUEST_*), 0 if there is no request.
+ * It is checked after every solver iteration. */
+volatile sig_atomic_t checkpointRequest = 0;
+
+
+/* External variable for the state of random(), which is
+ * also used by rand(). An int array keeps the alignment. */
+int checkpointRandomState[CHECKPOINT_RANDOM_STATE_SIZE / sizeof(int)];
+
+
+/* External variable which is true if a write to the
+ * checkpoint file failed. */
+bool checkpointWriteFailed;
+
+
+/* checkpointSeed()
+ *
+ * Seeds the random numbers with the state in
+ * checkpointRandomState, so it can be saved. */
+void checkpointSeed(unsigned int seed) {
+	initstate(seed, (char *)checkpointRandomState, CHECKPOINT_RANDOM_STATE_SIZE);
+}
+
+
+/* checkpointSignalHandler()
+ *
+ * Notes the request for the signal. The periodic alarm is
+ * rearmed. */
+void checkpointSignalHandler(int signalNumber) {
+	if (signalNumber == SIGTERM)
+		checkpointRequest = CHECKPOINT_REQUEST_TERMINATE;
+	else if (checkpointRequest == 0)
+		checkpointRequest = CHECKPOINT_REQUEST_WRITE;
+
+	if (signalNumber == SIGALRM)
+		alarm(checkpointInterval);
+}
+
+
+/* checkpointInitialisation()
+ *
+ * Installs the signal handlers. SIGTERM always prints the
+ * best solution candidate, SIGUSR1 and the periodic alarm
+ * only write checkpoints if there is a checkpoint file. */
+void checkpointInitialisation() {
+	struct sigaction signalAction;	/* The action for the handled signals. */
+
+
+	memset(&signalAction, 0, sizeof(signalAction));
+	signalAction.sa_handler = checkpointSignalHandler;
+	signalAction.sa_flags = SA_RESTART;
+	sigemptyset(&signalAction.sa_mask);
+
+	sigaction(SIGTERM, &signalAction, NULL);
+
+	if (strlen(checkpointFilePath) == 0)
+		return;
+
+	sigaction(SIGUSR1, &signalAction, NULL);
+	sigaction(SIGALRM, &signalAction, NULL);
+
+	if (checkpointInterval > 0)
+		alarm(checkpointInterval);
+}
+
+
+/* checkpointWriteData()
+ *
+ * Writes size bytes into the checkpoint file. */
+void checkpointWriteData(void *data, size_t size, FILE *checkpointFileHandle) {
+	if (fwrite(data, 1, size, checkpointFileHandle) != size)
+		checkpointWriteFailed = true;
+}
+
+
+/* checkpointReadData()
+ *
+ * Reads size bytes from the checkpoint file. */
+void checkpointReadData(void *data, size_t size, FILE *checkpointFileHandle) {
+	if (fread(data, 1, size, checkpointFileHandle) != size)
+		pExit("The checkpoint file \"%s\" is damaged!\n", checkpointFilePath);
+}
+
+
+/* checkpointWriteValues()
+ *
+ * Writes the values 1 to numValues of a solution
+ * candidate as bits into the checkpoint file. */
+void checkpointWriteValues(unsigned short *values, unsigned int numValues, FILE *checkpointFileHandle) {
+	unsigned int iValues;	/* Loop variable for the values. */
+	unsigned char bits;		/* The bits of eight values. */
+
+
+	for (iValues = 1, bits = 0; iValues <= numValues; iValues++) {
+		bits = bits | ((values[iValues] & 1) << ((iValues - 1) % 8));
+
+		if (iValues % 8 == 0 || iValues == numValues) {
+			checkpointWriteData(&bits, 1, checkpointFileHandle);
+			bits = 0;
+		}
+	}
+}
+
+
+/* checkpointReadValues()
+ *
+ * Reads the values 1 to numValues of a solution
+ * candidate (see checkpointWriteValues()). */
+void checkpointReadValues(unsigned short *values, unsigned int numValues, FILE *checkpointFileHandle) {
+	unsigned int iValues;	/* Loop variable for the values. */
+	unsigned char bits = 0;	/* The bits of eight values. */
+
+
+	for (iValues = 1; iValues <= numValues; iValues++) {
+		if ((iValues - 1) % 8 == 0)
+			checkpointReadData(&bits, 1, checkpointFileHandle);
+
+		values[iValues] = (bits >> ((iValues - 1) % 8)) & 1;
+	}
+}
+
+
+/* checkpointWriteHeader()
+ *
+ * Writes the header, which identifies the formula and the
+ * options of the search. */
+void checkpointWriteHeader(int ***clauseList, int ***varList, char algoName[], FILE *checkpointFileHandle) {
+	uint32_t headerValues[4];	/* Version, number of variables, number of clauses and the options. */
+	char headerAlgoName[16];	/* The algorithm name. */
+
+
+	headerValues[0] = CHECKPOINT_VERSION;
+	headerValues[1] = (*varList)[0][0];
+	headerValues[2] = (*clauseList)[0][0];
+	headerValues[3] = (reorderEnabled == true) | ((clauseWeightList != NULL) << 1);
+
+	memset(headerAlgoName, 0, sizeof(headerAlgoName));
+	strncpy(headerAlgoName, algoName, sizeof(headerAlgoName) - 1);
+
+	checkpointWriteData(CHECKPOINT_MAGIC, strlen(CHECKPOINT_MAGIC), checkpointFileHandle);
+	checkpointWriteData(headerValues, sizeof(headerValues), checkpointFileHandle);
+	checkpointWriteData(headerAlgoName, sizeof(headerAlgoName), checkpointFileHandle);
+}
+
+
+/* checkpointWrite()
+ *
+ * Writes the search state into the checkpoint file. The
+ * file is replaced atomically, so a failed write keeps the
+ * last checkpoint. */
+void checkpointWrite(unsigned int restartsCount, unsigned int solverIterations, unsigned int solverCutoff, unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, char algoName[]) {
+	char tmpFilePath[CHECKPOINT_FILE_PATH_MAXLENGTH + 5];	/* The path of the new checkpoint file. */
+	FILE *checkpointFileHandle;								/* File handle for the new checkpoint file. */
+	uint32_t counters[3];									/* The restart and iteration counters. */
+
+
+	snprintf(tmpFilePath, sizeof(tmpFilePath), "%s.tmp", checkpointFilePath);
+
+	checkpointFileHandle = fopen(tmpFilePath, "wb");
+	if (checkpointFileHandle == NULL) {
+		printf("c The checkpoint file \"%s\" can't be written!\n", tmpFilePath);
+		return;
+	}
+
+	checkpointWriteFailed = false;
+
+	checkpointWriteHeader(&(*clauseList), &(*varList), algoName, checkpointFileHandle);
+
+	counters[0] = restartsCount;
+	counters[1] = solverIterations;
+	counters[2] = solverCutoff;
+	checkpointWriteData(counters, sizeof(counters), checkpointFileHandle);
+
+	setstate((char *)checkpointRandomState);	/* Stores the position of random() in the state. */
+	checkpointWriteData(checkpointRandomState, CHECKPOINT_RANDOM_STATE_SIZE, checkpointFileHandle);
+
+	checkpointWriteValues(*solution, (*varList)[0][0], checkpointFileHandle);
+	checkpointWriteData(*varScoreList, ((*varList)[0][0] + 1) * sizeof(int), checkpointFileHandle);
+
+
+	/* States of the modules */
+	if (strcmp(algoName, "rots") == 0 || strcmp(algoName, "arots") == 0)
+		rotsWriteCheckpoint(checkpointFileHandle, &(*varList));
+	else if (strcmp(algoName, "ilssa") == 0)
+		ilssaWriteCheckpoint(checkpointFileHandle, &(*varList));
+
+	assignmentWriteCheckpoint(checkpointFileHandle, &(*solution), &(*varList));
+
+	restartWriteCheckpoint(checkpointFileHandle);
+
+	if (clauseWeightList != NULL)
+		weightedWriteCheckpoint(checkpointFileHandle, &(*varList));
+
+
+	if (fclose(checkpointFileHandle) != 0 || checkpointWriteFailed == true || rename(tmpFilePath, checkpointFilePath) != 0) {
+		printf("c The checkpoint file \"%s\" can't be written!\n", checkpointFilePath);
+		return;
+	}
+
+	printf("c Checkpoint written after %u restarts and %u solver iterations.\n", restartsCount, solverIterations);
+	fflush(stdout);
+}
+
+
+/* checkpointRead()
+ *
+ * Restores the search state from the checkpoint file. The
+ * algorithm and the modules must be initialised for the
+ * same formula and options. */
+void checkpointRead(unsigned int *restartsCount, unsigned int *solverIterations, unsigned int *solverCutoff, unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, int **clauseStatusList, char algoName[]) {
+	FILE *checkpointFileHandle;								/* File handle for the checkpoint file. */
+	char magic[sizeof(CHECKPOINT_MAGIC)];					/* The first bytes of the file. */
+	uint32_t headerValues[4];								/* See checkpointWriteHeader(). */
+	char headerAlgoName[16];								/* See checkpointWriteHeader(). */
+	uint32_t counters[3];									/* The restart and iteration counters. */
+	int randomState[CHECKPOINT_RANDOM_STATE_SIZE / sizeof(int)];	/* The state of random() from the file. */
+
+
+	checkpointFileHandle = fopen(checkpointFilePath, "rb");
+	if (checkpointFileHandle == NULL)
+		pExit("The checkpoint file \"%s\" can't be opened!\n", checkpointFilePath);
+
+	memset(magic, 0, sizeof(magic));
+	checkpointReadData(magic, strlen(CHECKPOINT_MAGIC), checkpointFileHandle);
+	checkpointReadData(headerValues, sizeof(headerValues), checkpointFileHandle);
+	checkpointReadData(headerAlgoName, sizeof(headerAlgoName), checkpointFileHandle);
+	headerAlgoName[sizeof(headerAlgoName) - 1] = '\0';
+
+	if (strcmp(magic, CHECKPOINT_MAGIC) != 0 || headerValues[0] != CHECKPOINT_VERSION)
+		pExit("The file \"%s\" is no checkpoint file of this version!\n", checkpointFilePath);
+
+	if (headerValues[1] != (*varList)[0][0] || headerValues[2] != (*clauseList)[0][0] || headerValues[3] != ((reorderEnabled == true) | ((clauseWeightList != NULL) << 1)) || strcmp(headerAlgoName, algoName) != 0)
+		pExit("The checkpoint file \"%s\" belongs to another formula, algorithm or renumbering (-o)!\n", checkpointFilePath);
+
+	checkpointReadData(counters, sizeof(counters), checkpointFileHandle);
+	*restartsCount = counters[0];
+	*solverIterations = counters[1];
+	*solverCutoff = counters[2];
+
+	checkpointReadData(randomState, CHECKPOINT_RANDOM_STATE_SIZE, checkpointFileHandle);
+
+	checkpointReadValues(*solution, (*varList)[0][0], checkpointFileHandle);
+
+	rebuildClauseStatusList(&(*solution), &(*clauseList), &(*clauseStatusList));
+
+	if (clauseWeightList != NULL)
+		weightedRebuildScoreList(&(*solution), &(*clauseList), &(*varList), &(*clauseStatusList));
+
+	checkpointReadData(*varScoreList, ((*varList)[0][0] + 1) * sizeof(int), checkpointFileHandle);
+
+
+	/* States of the modules */
+	if (strcmp(algoName, "rots") == 0 || strcmp(algoName, "arots") == 0)
+		rotsReadCheckpoint(checkpointFileHandle, &(*varList));
+	else if (strcmp(algoName, "ilssa") == 0)
+		ilssaReadCheckpoint(checkpointFileHandle, &(*varList));
+
+	assignmentReadCheckpoint(checkpointFileHandle, &(*varList));
+
+	restartReadCheckpoint(checkpointFileHandle);
+
+	if (clauseWeightList != NULL)
+		weightedReadCheckpoint(checkpointFileHandle, &(*varList));
+
+	fclose(checkpointFileHandle);
+
+
+	/* The active state of random() can't be overwritten, so
+	 * the state from the file is activated before it is
+	 * copied into checkpointRandomState. */
+	setstate((char *)randomState);
+	memcpy(checkpointRandomState, randomState, CHECKPOINT_RANDOM_STATE_SIZE);
+	setstate((char *)checkpointRandomState);
+
+	printf("c Resumed after %u restarts and %u solver iterations.\n", *restartsCount, *solverIterations);
+}
+
+
+/* checkpointHandleRequest()
+ *
+ * Handles the request of the signal handler: writes a
+ * checkpoint and after SIGTERM prints the best solution
+ * candidate so far and exits. */
+void checkpointHandleRequest(unsigned int restartsCount, unsigned int solverIterations, unsigned int solverCutoff, unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, char algoName[]) {
+	sig_atomic_t request = checkpointRequest;	/* The handled request. */
+	bool bestFound;								/* Is there a best solution candidate? */
+
+
+	checkpointRequest = 0;
+
+	if (strlen(checkpointFilePath) > 0)
+		checkpointWrite(restartsCount, solverIterations, solverCutoff, &(*solution), &(*clauseList), &(*varList), &(*varScoreList), algoName);
+
+	if (request != CHECKPOINT_REQUEST_TERMINATE)
+		return;
+
+
+	/* Print the best solution candidate so far */
+	if (clauseWeightList != NULL) {
+		bestFound = weightedGetBest(&(*solution), &(*varList));
+	} else {
+		assignmentSyncBest(&(*solution), &(*varList));
+
+		bestFound = (assignmentBestQuality < INT_MAX);
+		if (bestFound == true)
+			memcpy(&(*solution)[1], &assignmentBestSolution[1], (*varList)[0][0] * sizeof(unsigned short));
+	}
+
+	reorderRestoreSolution(&(*solution));
+
+	solverRestarts = restartsCount;
+
+	if (modelsFound > 0) {	/* The models are already printed (see --models). */
+		modelsFinish(-1);
+
+		fflush(stdout);
+
+		exit(EXIT_SUCCESS);
+	}
+
+	if (clauseWeightList != NULL) {
+		if (bestFound == true) {
+			printf("s SATISFIABLE\n");
+			printModel(*solution);
+			outputModelFile(*solution, solverNumVars);	/* It satisfies all hard clauses. */
+		} else {
+			printf("s UNKNOWN\n");
+		}
+
+		outputResult((bestFound == true ? "SATISFIABLE" : "UNKNOWN"), -1, (bestFound == true ? weightedBestCost : -1));
+	} else {
+		if (bestFound == true) {
+			printf("c Best solution candidate with %d unsatisfied clauses:\n", assignmentBestQuality);
+			printModel(*solution);
+		}
+
+		printf("s UNKNOWN\n");
+
+		outputResult("UNKNOWN", (bestFound == true ? assignmentBestQuality : -1), -1);
+	}
+
+	fflush(stdout);
+
+	exit(EXIT_SUCCESS);
+}
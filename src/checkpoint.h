@@ -0,0 +1,76 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * checkpoint.h
+ *
+ *    This is the header file for checkpoint.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "solver.h"
+
+
+#define CHECKPOINT_FILE_PATH_MAXLENGTH 255	/* The maximum length of the checkpoint file path. */
+#define CHECKPOINT_INTERVAL 600				/* The default number of seconds between two periodic checkpoints. */
+#define CHECKPOINT_MAGIC "PSATCKPT"			/* The first bytes of a checkpoint file. */
+#define CHECKPOINT_VERSION 1				/* The version of the checkpoint file format. */
+#define CHECKPOINT_RANDOM_STATE_SIZE 128	/* The size of the state of random() in bytes (the default size of glibc, so the numbers are the same as after srand()). */
+
+/* The requests set by the signal handler. */
+#define CHECKPOINT_REQUEST_WRITE 1		/* Write a checkpoint (SIGUSR1 or periodic) */
+#define CHECKPOINT_REQUEST_TERMINATE 2	/* Write a checkpoint, print the best solution candidate and exit (SIGTERM) */
+
+
+extern char checkpointFilePath[CHECKPOINT_FILE_PATH_MAXLENGTH + 1];
+
+extern unsigned int checkpointInterval;
+
+extern bool checkpointResume;
+
+extern volatile sig_atomic_t checkpointRequest;
+
+
+void checkpointSeed(unsigned int seed);
+
+void checkpointSignalHandler(int signalNumber);
+
+void checkpointInitialisation();
+
+void checkpointWriteData(void *data, size_t size, FILE *checkpointFileHandle);
+
+void checkpointReadData(void *data, size_t size, FILE *checkpointFileHandle);
+
+void checkpointWriteValues(unsigned short *values, unsigned int numValues, FILE *checkpointFileHandle);
+
+void checkpointReadValues(unsigned short *values, unsigned int numValues, FILE *checkpointFileHandle);
+
+void checkpointWrite(unsigned int restartsCount, unsigned int solverIterations, unsigned int solverCutoff, unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, char algoName[]);
+
+void checkpointRead(unsigned int *restartsCount, unsigned int *solverIterations, unsigned int *solverCutoff, unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, int **clauseStatusList, char algoName[]);
+
+void checkpointHandleRequest(unsigned int restartsCount, unsigned int solverIterations, unsigned int solverCutoff, unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, char algoName[]);
+
+
+#endif /* CHECKPOINT_H */
@@ -0,0 +1,978 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * daemon.c
+ *
+ * 	This file contains the solver daemon (--daemon <socket>).
+ *  The daemon listens on a Unix domain socket and solves
+ *  the requests of its clients. Every connection carries
+ *  one request line:
+ *  - "solve [algo=<name>] [seed=<n>] [restarts=<n>]
+ *    [timeout=<seconds>] file=<path>" or the same with
+ *    "inline=<bytes>" instead of the file, followed by the
+ *    given number of bytes of the formula in the DIMACS
+ *    format. The other parameters default to the options
+ *    of the daemon (-a, -r, -n). The daemon answers with
+ *    "c Request <id>", then the worker prints the output of
+ *    psat ("c" lines, the "v" line and the "s" line). Sending
+ *    "cancel" on the connection or "cancel <id>" on another
+ *    one ends the search like SIGTERM: the best solution
+ *    candidate and "s UNKNOWN" are printed. A closed
+ *    connection kills the worker.
+ *  - "stats": the numbers of the cache and the workers.
+ *  - "shutdown": the daemon ends like on SIGTERM.
+ *
+ *  The parsed formulas are kept in an LRU cache, which is
+ *  keyed by the 128 bit FNV-1a hash and the size of the
+ *  content of the formula.
+ *  A cached formula is an image (see portfolioImageWrite())
+ *  in a shared read-only mapping, so a request for it
+ *  doesn't parse anything: the worker only attaches it
+ *  (see portfolioAttach()). The cache is limited by the
+ *  number of formulas (--cache) and their size
+ *  (--cache-memory), the least recently used formula is
+ *  evicted first.
+ *
+ *  The request lines and the inline formulas are received
+ *  and the formulas are hashed without blocking the daemon:
+ *  each pass of its loop reads what arrived and at most
+ *  DAEMON_RECEIVE_CHUNKS buffers of an instance file, so a
+ *  slow client or a large file only delays its own request.
+ *  A client which doesn't send the next bytes of its request
+ *  in DAEMON_RECEIVE_TIMEOUT seconds is disconnected.
+ *
+ *  Every request is searched by a forked worker process,
+ *  at most --workers at once, the others wait in the order
+ *  of their arrival. A worker of a formula which is not
+ *  cached parses it and writes its image into a memory
+ *  file, which the daemon adds to the cache after the
+ *  worker ended. A worker which doesn't end DAEMON_GRACE
+ *  seconds after a timeout or a cancellation is killed.
+ *  Errors of a formula only end its worker.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#define _GNU_SOURCE	/* memfd_create() */
+
+#include "daemon.h"
+
+
+/* The states of a request. */
+#define DAEMON_REQUEST_FREE 0
+#define DAEMON_REQUEST_QUEUED 1
+#define DAEMON_REQUEST_RUNNING 2
+#define DAEMON_REQUEST_LINE 3		/* The request line is received. */
+#define DAEMON_REQUEST_RECEIVING 4	/* The formula is received and hashed. */
+
+#define DAEMON_HASH_BASIS (((unsigned __int128)0x6c62272e07bb0142ULL << 64) | 0x62b821756295c58dULL)	/* FNV-1a 128 bit */
+#define DAEMON_HASH_PRIME (((unsigned __int128)1 << 88) | 0x13B)
+
+
+/* External variable for the path to the socket. */
+char daemonSocketPath[DAEMON_SOCKET_PATH_MAXLENGTH + 1] = "";
+
+
+/* External variables for the options of the number of
+ * workers (0 = the number of processors), the number of
+ * cached formulas and the MiB of the cache. */
+unsigned int daemonWorkers = 0;
+unsigned int daemonCacheEntries = DAEMON_CACHE_ENTRIES;
+unsigned int daemonCacheMemory = DAEMON_CACHE_MEMORY;
+
+
+/* External variable which is set by SIGTERM, SIGINT and
+ * the "shutdown" request. */
+volatile sig_atomic_t daemonStop = 0;
+
+
+/* External variable for the listening socket. */
+int daemonSocket = -1;
+
+
+/* External variables for the requests. Each request has a
+ * slot with its state, its id, its connection, the file
+ * of its formula (the instance file or the memory file of
+ * an inline formula, open until the worker started), the
+ * memory file for the image of a formula which is not
+ * cached, its worker, the hash and the size of its formula
+ * and its parameters. The request line, the bytes of an
+ * inline formula which didn't arrive yet and the timeout
+ * are kept until the request is queued. The deadline
+ * (0 = none) is the time of the timeout, the end of the
+ * grace after a signal to the worker or, while the request
+ * arrives, the time its next bytes are due. */
+unsigned char daemonRequestState[DAEMON_REQUESTS_MAX];
+unsigned int daemonRequestId[DAEMON_REQUESTS_MAX];
+int daemonRequestFd[DAEMON_REQUESTS_MAX];
+int daemonRequestContentFd[DAEMON_REQUESTS_MAX];
+int daemonRequestImageFd[DAEMON_REQUESTS_MAX];
+pid_t daemonRequestPid[DAEMON_REQUESTS_MAX];
+int daemonRequestSignal[DAEMON_REQUESTS_MAX];
+bool daemonRequestEof[DAEMON_REQUESTS_MAX];
+unsigned __int128 daemonRequestHash[DAEMON_REQUESTS_MAX];
+unsigned long long daemonRequestSize[DAEMON_REQUESTS_MAX];
+char daemonRequestAlgoName[DAEMON_REQUESTS_MAX][PSAT_ALGONAME_MAXLENGTH + 1];
+unsigned int daemonRequestSeed[DAEMON_REQUESTS_MAX];
+unsigned int daemonRequestRestarts[DAEMON_REQUESTS_MAX];
+double daemonRequestDeadline[DAEMON_REQUESTS_MAX];
+char daemonRequestLine[DAEMON_REQUESTS_MAX][DAEMON_LINE_MAXLENGTH + 1];
+unsigned int daemonRequestLineLength[DAEMON_REQUESTS_MAX];
+bool daemonRequestInline[DAEMON_REQUESTS_MAX];
+unsigned long long daemonRequestRemaining[DAEMON_REQUESTS_MAX];
+double daemonRequestTimeout[DAEMON_REQUESTS_MAX];
+
+unsigned int daemonRequestCount = 0;	/* The id of the last request. */
+unsigned int daemonRunning = 0;			/* The number of running workers. */
+
+
+/* External variables for the cache. Each formula has its
+ * hash and size, its image (the first integer is 1, when the image
+ * is complete), the bytes of the image and the tick of its
+ * last use. */
+unsigned int daemonCacheCount = 0;
+unsigned __int128 daemonCacheHash[DAEMON_CACHE_MAX];
+unsigned long long daemonCacheSize[DAEMON_CACHE_MAX];
+int *daemonCacheImage[DAEMON_CACHE_MAX];
+size_t daemonCacheBytes[DAEMON_CACHE_MAX];
+unsigned long long daemonCacheUsed[DAEMON_CACHE_MAX];
+unsigned long long daemonCacheTick = 0;
+size_t daemonCacheTotal = 0;
+unsigned long long daemonCacheHits = 0;
+unsigned long long daemonCacheMisses = 0;
+
+
+/* daemonSignalHandler()
+ *
+ * SIGTERM and SIGINT stop the daemon, SIGCHLD only
+ * interrupts poll(). */
+void daemonSignalHandler(int signalNumber) {
+	if (signalNumber != SIGCHLD)
+		daemonStop = 1;
+}
+
+
+/* daemonNow()
+ *
+ * Returns the seconds of the monotonic clock. */
+double daemonNow() {
+	struct timespec now;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/* daemonReply()
+ *
+ * Writes a formatted message to a connection. */
+void daemonReply(int fd, const char message[], ...) {
+	va_list args;
+
+
+	va_start(args, message);
+	vdprintf(fd, message, args);
+	va_end(args);
+}
+
+
+/* daemonHash()
+ *
+ * Continues the FNV-1a hash with the bytes of the
+ * buffer. */
+unsigned __int128 daemonHash(unsigned __int128 hash, unsigned char buffer[], size_t length) {
+	size_t iBuffer;	/* Loop variable for the buffer. */
+
+
+	for (iBuffer = 0; iBuffer < length; iBuffer++)
+		hash = (hash ^ buffer[iBuffer]) * DAEMON_HASH_PRIME;
+
+	return hash;
+}
+
+
+/* daemonCacheFind()
+ *
+ * Returns the index of the cached formula with the hash
+ * and the size or -1. */
+int daemonCacheFind(unsigned __int128 hash, unsigned long long size) {
+	unsigned int iCache;	/* Loop variable for the cache. */
+
+
+	for (iCache = 0; iCache < daemonCacheCount; iCache++) {
+		if (daemonCacheHash[iCache] == hash && daemonCacheSize[iCache] == size)
+			return iCache;
+	}
+
+	return -1;
+}
+
+
+/* daemonCacheRemove()
+ *
+ * Removes a formula from the cache. Workers which attached
+ * it keep their own mapping. */
+void daemonCacheRemove(unsigned int index) {
+	munmap(daemonCacheImage[index], daemonCacheBytes[index]);
+	daemonCacheTotal = daemonCacheTotal - daemonCacheBytes[index];
+
+	daemonCacheCount--;
+
+	daemonCacheHash[index] = daemonCacheHash[daemonCacheCount];
+	daemonCacheSize[index] = daemonCacheSize[daemonCacheCount];
+	daemonCacheImage[index] = daemonCacheImage[daemonCacheCount];
+	daemonCacheBytes[index] = daemonCacheBytes[daemonCacheCount];
+	daemonCacheUsed[index] = daemonCacheUsed[daemonCacheCount];
+}
+
+
+/* daemonCacheInsert()
+ *
+ * Adds the image of the memory file to the cache, if it is
+ * complete, and evicts the least recently used formulas
+ * until it fits. */
+void daemonCacheInsert(unsigned __int128 hash, unsigned long long size, int imageFd) {
+	struct stat imageStat;		/* The size of the image. */
+	int *image;					/* The mapping of the image. */
+	unsigned int iCache;		/* Loop variable for the cache. */
+	unsigned int evicted;		/* The least recently used formula. */
+	size_t limit = (size_t)daemonCacheMemory * 1048576;	/* Bytes of the cache. */
+
+
+	if (fstat(imageFd, &imageStat) != 0 || imageStat.st_size < (off_t)sizeof(int) || (size_t)imageStat.st_size > limit || daemonCacheEntries == 0 || daemonCacheFind(hash, size) >= 0)
+		return;
+
+	image = mmap(NULL, imageStat.st_size, PROT_READ, MAP_SHARED, imageFd, 0);
+	if (image == MAP_FAILED)
+		return;
+
+	if (image[0] != 1) {	/* The worker ended before the image was complete. */
+		munmap(image, imageStat.st_size);
+		return;
+	}
+
+	while (daemonCacheCount > 0 && (daemonCacheCount >= daemonCacheEntries || daemonCacheTotal + imageStat.st_size > limit)) {
+		evicted = 0;
+
+		for (iCache = 1; iCache < daemonCacheCount; iCache++) {
+			if (daemonCacheUsed[iCache] < daemonCacheUsed[evicted])
+				evicted = iCache;
+		}
+
+		daemonCacheRemove(evicted);
+	}
+
+	daemonCacheTick++;
+
+	daemonCacheHash[daemonCacheCount] = hash;
+	daemonCacheSize[daemonCacheCount] = size;
+	daemonCacheImage[daemonCacheCount] = image;
+	daemonCacheBytes[daemonCacheCount] = imageStat.st_size;
+	daemonCacheUsed[daemonCacheCount] = daemonCacheTick;
+	daemonCacheCount++;
+
+	daemonCacheTotal = daemonCacheTotal + imageStat.st_size;
+}
+
+
+/* daemonFree()
+ *
+ * Closes the connection and the files of a request and
+ * frees its slot. */
+void daemonFree(unsigned int slot) {
+	close(daemonRequestFd[slot]);
+
+	if (daemonRequestContentFd[slot] >= 0)
+		close(daemonRequestContentFd[slot]);
+
+	if (daemonRequestImageFd[slot] >= 0)
+		close(daemonRequestImageFd[slot]);
+
+	daemonRequestState[slot] = DAEMON_REQUEST_FREE;
+}
+
+
+/* daemonCancel()
+ *
+ * Cancels a request: a queued request ends at once, a
+ * request which is still arriving is dropped, the worker
+ * of a running request gets SIGTERM (it prints the best
+ * solution candidate) and SIGKILL, if it is still running
+ * after DAEMON_GRACE seconds or if force is true. */
+void daemonCancel(unsigned int slot, bool force) {
+	if (daemonRequestState[slot] == DAEMON_REQUEST_QUEUED) {
+		daemonReply(daemonRequestFd[slot], "s UNKNOWN\n");
+		daemonFree(slot);
+	} else if (daemonRequestState[slot] != DAEMON_REQUEST_RUNNING) {
+		daemonFree(slot);
+	} else if (daemonRequestSignal[slot] == 0 && force == false) {
+		kill(daemonRequestPid[slot], SIGTERM);
+		daemonRequestSignal[slot] = SIGTERM;
+		daemonRequestDeadline[slot] = daemonNow() + DAEMON_GRACE;
+	} else if (daemonRequestSignal[slot] != SIGKILL) {
+		kill(daemonRequestPid[slot], SIGKILL);
+		daemonRequestSignal[slot] = SIGKILL;
+		daemonRequestDeadline[slot] = 0;
+	}
+}
+
+
+/* daemonReceiveFormula()
+ *
+ * Continues the formula of a request without blocking: the
+ * bytes of an inline formula which arrived are written to
+ * its memory file, at most DAEMON_RECEIVE_CHUNKS buffers of
+ * an instance file are read, and both are hashed. The
+ * request is queued, when its formula is complete. */
+void daemonReceiveFormula(unsigned int slot) {
+	unsigned char buffer[DAEMON_BUFFER];	/* Buffer for the formula. */
+	ssize_t length;							/* Bytes of the last read. */
+	unsigned int iChunks;					/* Loop variable for the buffers. */
+	bool complete;							/* The formula is complete. */
+
+
+	complete = (daemonRequestInline[slot] == true && daemonRequestRemaining[slot] == 0);
+
+	for (iChunks = 0; complete == false && iChunks < DAEMON_RECEIVE_CHUNKS; iChunks++) {
+		if (daemonRequestInline[slot] == true) {
+			length = read(daemonRequestFd[slot], buffer, (daemonRequestRemaining[slot] < DAEMON_BUFFER ? daemonRequestRemaining[slot] : DAEMON_BUFFER));
+
+			if (length < 0 && (errno == EAGAIN || errno == EINTR))
+				return;	/* The next bytes didn't arrive yet. */
+
+			if (length <= 0 || write(daemonRequestContentFd[slot], buffer, length) != length) {
+				daemonReply(daemonRequestFd[slot], "The inline formula is incomplete!\n");
+				daemonFree(slot);
+				return;
+			}
+
+			daemonRequestRemaining[slot] = daemonRequestRemaining[slot] - length;
+			daemonRequestDeadline[slot] = daemonNow() + DAEMON_RECEIVE_TIMEOUT;
+
+			complete = (daemonRequestRemaining[slot] == 0);
+		} else {
+			length = read(daemonRequestContentFd[slot], buffer, DAEMON_BUFFER);
+
+			if (length < 0) {
+				daemonReply(daemonRequestFd[slot], "Can't read instance file!\n");
+				daemonFree(slot);
+				return;
+			}
+
+			complete = (length == 0);
+		}
+
+		daemonRequestHash[slot] = daemonHash(daemonRequestHash[slot], buffer, length);
+		daemonRequestSize[slot] = daemonRequestSize[slot] + length;
+	}
+
+	if (complete == false)
+		return;
+
+	daemonRequestCount++;
+
+	daemonRequestState[slot] = DAEMON_REQUEST_QUEUED;
+	daemonRequestId[slot] = daemonRequestCount;
+	daemonRequestDeadline[slot] = (daemonRequestTimeout[slot] > 0 ? daemonNow() + daemonRequestTimeout[slot] : 0);	/* The time in the queue counts. */
+
+	daemonReply(daemonRequestFd[slot], "c Request %u\n", daemonRequestCount);
+}
+
+
+/* daemonSolve()
+ *
+ * Prepares a "solve" request: the parameters are read from
+ * the tokens of the line and the file of the formula is
+ * opened. The formula is received and hashed by
+ * daemonReceiveFormula(). The function returns false, if
+ * the request is invalid. */
+bool daemonSolve(unsigned int slot, char line[], char algoName[], unsigned int maxRestarts, unsigned int randomSeed) {
+	char *token;						/* Current token of the line. */
+	char *value;						/* Value of the current token. */
+	int fd = daemonRequestFd[slot];		/* The connection. */
+	int contentFd = -1;					/* The file of the formula. */
+	unsigned long long inlineBytes = 0;	/* Bytes of an inline formula. */
+	bool inlineFormula = false;			/* The formula follows the line. */
+	double timeout = 0;					/* Seconds of the timeout (0 = none). */
+
+
+	strcpy(daemonRequestAlgoName[slot], algoName);
+	daemonRequestSeed[slot] = randomSeed;
+	daemonRequestRestarts[slot] = maxRestarts;
+
+	for (token = strtok(line, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n")) {
+		value = strchr(token, '=');
+
+		if (value == NULL) {
+			daemonReply(fd, "The parameter \"%s\" has no value!\n", token);
+			break;
+		}
+
+		*value = '\0';
+		value++;
+
+		if (strcmp(token, "algo") == 0 && strlen(value) <= PSAT_ALGONAME_MAXLENGTH) {
+			strcpy(daemonRequestAlgoName[slot], value);
+		} else if (strcmp(token, "seed") == 0 && sscanf(value, "%u", &daemonRequestSeed[slot]) == 1) {
+			/* Nothing to do */
+		} else if (strcmp(token, "restarts") == 0 && sscanf(value, "%u", &daemonRequestRestarts[slot]) == 1 && daemonRequestRestarts[slot] > 0) {
+			/* Nothing to do */
+		} else if (strcmp(token, "timeout") == 0 && sscanf(value, "%lf", &timeout) == 1 && timeout >= 0) {
+			/* Nothing to do */
+		} else if (strcmp(token, "file") == 0 && contentFd == -1) {
+			contentFd = open(value, O_RDONLY);
+
+			if (contentFd == -1) {
+				daemonReply(fd, "Can't open instance file!\n");
+				return false;
+			}
+		} else if (strcmp(token, "inline") == 0 && contentFd == -1 && sscanf(value, "%llu", &inlineBytes) == 1) {
+			contentFd = memfd_create("psat-formula", 0);
+			inlineFormula = true;
+
+			if (contentFd == -1) {
+				daemonReply(fd, "memfd_create() for the formula failed: %s\n", strerror(errno));
+				return false;
+			}
+		} else {
+			daemonReply(fd, "The parameter \"%s\" is invalid!\n", token);
+			break;
+		}
+	}
+
+	if (token != NULL || contentFd == -1 || (strcmp(daemonRequestAlgoName[slot], "rots") != 0 && strcmp(daemonRequestAlgoName[slot], "arots") != 0 && strcmp(daemonRequestAlgoName[slot], "ilssa") != 0 && strcmp(daemonRequestAlgoName[slot], "auto") != 0)) {
+		if (token == NULL)
+			daemonReply(fd, "A request needs a known algorithm and \"file=<path>\" or \"inline=<bytes>\"!\n");
+
+		if (contentFd >= 0)
+			close(contentFd);
+
+		return false;
+	}
+
+	daemonRequestState[slot] = DAEMON_REQUEST_RECEIVING;
+	daemonRequestContentFd[slot] = contentFd;
+	daemonRequestInline[slot] = inlineFormula;
+	daemonRequestRemaining[slot] = inlineBytes;
+	daemonRequestTimeout[slot] = timeout;
+	daemonRequestHash[slot] = DAEMON_HASH_BASIS;
+	daemonRequestSize[slot] = 0;
+	daemonRequestDeadline[slot] = (inlineFormula == true ? daemonNow() + DAEMON_RECEIVE_TIMEOUT : 0);
+
+	return true;
+}
+
+
+/* daemonReceiveLine()
+ *
+ * Continues the request line of a connection without
+ * blocking and handles it, when it is complete. Nothing is
+ * read after the line. */
+void daemonReceiveLine(unsigned int slot, char algoName[], unsigned int maxRestarts, unsigned int randomSeed) {
+	char *line = daemonRequestLine[slot];	/* The request line. */
+	int fd = daemonRequestFd[slot];			/* The connection. */
+	ssize_t length;							/* Bytes of the last read. */
+	unsigned int requestId;					/* The id of a "cancel" request. */
+	unsigned int iRequests;					/* Loop variable for the requests. */
+
+
+	while (daemonRequestLineLength[slot] < DAEMON_LINE_MAXLENGTH) {
+		length = read(fd, &line[daemonRequestLineLength[slot]], 1);
+
+		if (length < 0 && (errno == EAGAIN || errno == EINTR))
+			return;	/* The rest of the line didn't arrive yet. */
+
+		if (length < 0) {
+			daemonFree(slot);
+			return;
+		}
+
+		if (length == 0) {	/* The client only closed its sending side. */
+			daemonRequestEof[slot] = true;
+			break;
+		}
+
+		if (line[daemonRequestLineLength[slot]] == '\n')
+			break;
+
+		daemonRequestLineLength[slot]++;
+	}
+
+	line[daemonRequestLineLength[slot]] = '\0';
+
+	if (strncmp(line, "solve", 5) == 0 && (line[5] == ' ' || line[5] == '\0')) {
+		if (daemonSolve(slot, &line[5], algoName, maxRestarts, randomSeed) == true) {
+			daemonReceiveFormula(slot);
+			return;	/* The connection stays open. */
+		}
+	} else if (strcmp(line, "stats") == 0) {
+		daemonReply(fd, "c Cache: %u formulas, %.1f MiB, %llu hits, %llu misses\n", daemonCacheCount, daemonCacheTotal / 1048576.0, daemonCacheHits, daemonCacheMisses);
+		daemonReply(fd, "c Workers: %u running, %u requests, %u at most\n", daemonRunning, daemonRequestCount, daemonWorkers);
+	} else if (sscanf(line, "cancel %u", &requestId) == 1) {
+		for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+			if ((daemonRequestState[iRequests] == DAEMON_REQUEST_QUEUED || daemonRequestState[iRequests] == DAEMON_REQUEST_RUNNING) && daemonRequestId[iRequests] == requestId)
+				break;
+		}
+
+		if (iRequests < DAEMON_REQUESTS_MAX) {
+			daemonCancel(iRequests, false);
+			daemonReply(fd, "c Request %u cancelled\n", requestId);
+		} else {
+			daemonReply(fd, "The request %u is unknown!\n", requestId);
+		}
+	} else if (strcmp(line, "shutdown") == 0) {
+		daemonStop = 1;
+		daemonReply(fd, "c Shutdown\n");
+	} else {
+		daemonReply(fd, "The request \"%s\" is unknown!\n", line);
+	}
+
+	daemonFree(slot);
+}
+
+
+/* daemonAccept()
+ *
+ * Accepts a connection and gives it a slot for its
+ * request. */
+void daemonAccept() {
+	unsigned int slot;	/* The free slot of the request. */
+	int fd;				/* The connection. */
+
+
+	fd = accept(daemonSocket, NULL, NULL);
+	if (fd == -1)
+		return;
+
+	for (slot = 0; slot < DAEMON_REQUESTS_MAX; slot++) {
+		if (daemonRequestState[slot] == DAEMON_REQUEST_FREE)
+			break;
+	}
+
+	if (slot == DAEMON_REQUESTS_MAX) {
+		daemonReply(fd, "The daemon has already %d requests!\n", DAEMON_REQUESTS_MAX);
+		close(fd);
+		return;
+	}
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+	daemonRequestState[slot] = DAEMON_REQUEST_LINE;
+	daemonRequestId[slot] = 0;
+	daemonRequestFd[slot] = fd;
+	daemonRequestContentFd[slot] = -1;
+	daemonRequestImageFd[slot] = -1;
+	daemonRequestSignal[slot] = 0;
+	daemonRequestEof[slot] = false;
+	daemonRequestLineLength[slot] = 0;
+	daemonRequestDeadline[slot] = daemonNow() + DAEMON_RECEIVE_TIMEOUT;
+}
+
+
+/* daemonWorker()
+ *
+ * Searches a request in the forked worker. A cached formula
+ * is attached, otherwise the formula is parsed and its
+ * image is written for the cache. The output of the search
+ * goes to the connection. The worker exits, its memory is
+ * released with it. */
+void daemonWorker(unsigned int slot, int *image) {
+	char instanceFilePath[PSAT_INSTANCEFILE_PATH_MAXLENGTH + 1];	/* The path of the formula file. */
+	int **clauseList;					/* The formula (see solver()) */
+	int **varList;
+	int *varScoreList;
+	int *clauseStatusList;
+	int *flippedVariables;
+	unsigned short *solution;
+	int *imageCopy;						/* The mapping of the image for the cache. */
+	size_t imageSize;					/* Number of integers of the image. */
+	unsigned int iRequests;				/* Loop variable for the requests. */
+	double start;						/* Begin of the request. */
+	double loaded;						/* End of the parsing or the attaching. */
+	int solutionQuality;				/* The result of the search. */
+
+
+	prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+	signal(SIGPIPE, SIG_DFL);
+	signal(SIGCHLD, SIG_DFL);
+	signal(SIGINT, SIG_DFL);
+
+	close(daemonSocket);
+
+	for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {	/* The other connections end with their own requests. */
+		if (iRequests != slot && daemonRequestState[iRequests] != DAEMON_REQUEST_FREE)
+			daemonFree(iRequests);
+	}
+
+	fcntl(daemonRequestFd[slot], F_SETFL, fcntl(daemonRequestFd[slot], F_GETFL) & ~O_NONBLOCK);	/* The output of the search must not get lost. */
+	dup2(daemonRequestFd[slot], STDOUT_FILENO);
+
+	checkpointInitialisation();	/* SIGTERM prints the best solution candidate. */
+	checkpointSeed(daemonRequestSeed[slot]);
+
+	if (parallelThreads > 1)
+		parallelInitialisation();
+
+	start = daemonNow();
+
+	if (image != NULL) {
+		portfolioAttach(&image[1]);
+
+		clauseList = portfolioClauseList;
+		varList = portfolioVarList;
+		varScoreList = portfolioVarScoreList;
+		clauseStatusList = portfolioClauseStatusList;
+		flippedVariables = portfolioFlippedVariables;
+		solution = portfolioSolution;
+	} else {
+		sprintf(instanceFilePath, "/proc/self/fd/%d", daemonRequestContentFd[slot]);
+
+		readInstanceFile(instanceFilePath, &clauseList, &varList, &varScoreList, &solution, &clauseStatusList, &flippedVariables);
+
+		if (clauseWeightList != NULL)
+			pExit("The daemon doesn't support weighted instances.\n");
+
+		imageSize = portfolioImageSize(&clauseList, &varList);
+
+		if (ftruncate(daemonRequestImageFd[slot], sizeof(int) * (imageSize + 1)) == 0) {
+			imageCopy = mmap(NULL, sizeof(int) * (imageSize + 1), PROT_READ | PROT_WRITE, MAP_SHARED, daemonRequestImageFd[slot], 0);
+
+			if (imageCopy != MAP_FAILED) {
+				portfolioImageWrite(&imageCopy[1], &clauseList, &varList);
+				imageCopy[0] = 1;	/* The image is complete. */
+
+				munmap(imageCopy, sizeof(int) * (imageSize + 1));
+			}
+		}
+	}
+
+	loaded = daemonNow();
+
+	printf("c Request %u: formula %s in %.3f s\n", daemonRequestId[slot], (image != NULL ? "from the cache" : "parsed"), loaded - start);
+
+	if (strcmp(daemonRequestAlgoName[slot], "auto") == 0)
+		featuresSelect(&clauseList, &varList, daemonRequestAlgoName[slot]);
+
+	solutionQuality = solverSearch(&solution, &clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables, daemonRequestAlgoName[slot], daemonRequestRestarts[slot], false);
+
+	printf("c Request %u: search in %.3f s\n", daemonRequestId[slot], daemonNow() - loaded);
+
+	if (solutionQuality == 0)
+		printSolution(solution);
+	else
+		printf("s UNKNOWN\n");
+
+	exit(EXIT_SUCCESS);
+}
+
+
+/* daemonStart()
+ *
+ * Starts the worker of a queued request. */
+void daemonStart(unsigned int slot) {
+	int cached;	/* Index of the formula in the cache or -1. */
+
+
+	cached = daemonCacheFind(daemonRequestHash[slot], daemonRequestSize[slot]);
+
+	if (cached >= 0) {
+		daemonCacheHits++;
+		daemonCacheTick++;
+		daemonCacheUsed[cached] = daemonCacheTick;
+	} else {
+		daemonCacheMisses++;
+		daemonRequestImageFd[slot] = memfd_create("psat-image", 0);
+	}
+
+	fflush(stdout);	/* The worker doesn't print the buffer of the daemon. */
+
+	daemonRequestPid[slot] = fork();
+
+	if (daemonRequestPid[slot] == 0)
+		daemonWorker(slot, (cached >= 0 ? daemonCacheImage[cached] : NULL));
+
+	if (daemonRequestPid[slot] == -1) {
+		daemonReply(daemonRequestFd[slot], "fork() for the worker failed: %s\n", strerror(errno));
+		daemonFree(slot);
+		return;
+	}
+
+	close(daemonRequestContentFd[slot]);	/* Only the worker reads the formula. */
+	daemonRequestContentFd[slot] = -1;
+
+	daemonRequestState[slot] = DAEMON_REQUEST_RUNNING;
+	daemonRunning++;
+}
+
+
+/* daemonReap()
+ *
+ * Ends the requests of the ended workers and adds the
+ * images of their formulas to the cache. */
+void daemonReap() {
+	pid_t processId;		/* The ended worker. */
+	int processStatus;		/* Its exit status. */
+	unsigned int iRequests;	/* Loop variable for the requests. */
+
+
+	while ((processId = waitpid(-1, &processStatus, WNOHANG)) > 0) {
+		for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+			if (daemonRequestState[iRequests] == DAEMON_REQUEST_RUNNING && daemonRequestPid[iRequests] == processId)
+				break;
+		}
+
+		if (iRequests == DAEMON_REQUESTS_MAX)
+			continue;
+
+		if (daemonRequestImageFd[iRequests] >= 0)
+			daemonCacheInsert(daemonRequestHash[iRequests], daemonRequestSize[iRequests], daemonRequestImageFd[iRequests]);
+
+		if (WIFSIGNALED(processStatus))
+			daemonReply(daemonRequestFd[iRequests], "c Request %u: worker ended by signal %d\ns UNKNOWN\n", daemonRequestId[iRequests], WTERMSIG(processStatus));
+
+		daemonRunning--;
+		daemonFree(iRequests);
+	}
+}
+
+
+/* daemonListen()
+ *
+ * Creates the listening socket. The socket file of a
+ * daemon which doesn't run anymore is replaced. */
+void daemonListen() {
+	struct sockaddr_un address;	/* The address of the socket. */
+	int probe;					/* Socket to check an existing socket file. */
+
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, daemonSocketPath);
+
+	daemonSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (daemonSocket == -1)
+		pExit("socket() for the daemon failed: %s\n", strerror(errno));
+
+	if (bind(daemonSocket, (struct sockaddr *)&address, sizeof(address)) != 0) {
+		probe = socket(AF_UNIX, SOCK_STREAM, 0);
+
+		if (errno != EADDRINUSE || connect(probe, (struct sockaddr *)&address, sizeof(address)) == 0)
+			pExit("Can't listen on the socket %s: %s\n", daemonSocketPath, (errno == EADDRINUSE ? "another daemon is running" : strerror(errno)));
+
+		close(probe);
+		unlink(daemonSocketPath);
+
+		if (bind(daemonSocket, (struct sockaddr *)&address, sizeof(address)) != 0)
+			pExit("Can't listen on the socket %s: %s\n", daemonSocketPath, strerror(errno));
+	}
+
+	if (listen(daemonSocket, DAEMON_BACKLOG) != 0)
+		pExit("Can't listen on the socket %s: %s\n", daemonSocketPath, strerror(errno));
+}
+
+
+/* daemonRun()
+ *
+ * The daemon: listens on the socket, queues the requests,
+ * starts their workers, watches their connections and
+ * timeouts and caches the formulas until SIGTERM, SIGINT or
+ * a "shutdown" request. The algorithm, the number of
+ * restarts and the seed are the defaults of the
+ * requests. */
+void daemonRun(char algoName[], unsigned int maxRestarts, unsigned int randomSeed) {
+	struct sigaction signalAction;			/* The action for the handled signals. */
+	struct pollfd pollFds[DAEMON_REQUESTS_MAX + 1];	/* The socket and the connections. */
+	unsigned int pollSlots[DAEMON_REQUESTS_MAX + 1];	/* The request of each connection. */
+	unsigned int numPollFds;				/* Number of watched descriptors. */
+	unsigned int iRequests;					/* Loop variable for the requests. */
+	unsigned int iPollFds;					/* Loop variable for the descriptors. */
+	unsigned int next;						/* The queued request which arrived first. */
+	char buffer[DAEMON_LINE_MAXLENGTH];		/* Bytes sent during a request. */
+	ssize_t length;							/* Bytes of the last read. */
+	double now;								/* The current time. */
+	double deadline;						/* The next deadline. */
+	bool hashing;							/* An instance file is hashed. */
+	double stop;							/* End of the grace at the shutdown. */
+	int pollTimeout;						/* Milliseconds of poll(). */
+
+
+	if (daemonWorkers == 0)
+		daemonWorkers = (sysconf(_SC_NPROCESSORS_ONLN) > 0 ? sysconf(_SC_NPROCESSORS_ONLN) : 1);
+
+	if (daemonCacheEntries > DAEMON_CACHE_MAX)
+		daemonCacheEntries = DAEMON_CACHE_MAX;
+
+	memset(daemonRequestState, DAEMON_REQUEST_FREE, sizeof(daemonRequestState));
+
+	memset(&signalAction, 0, sizeof(signalAction));
+	signalAction.sa_handler = daemonSignalHandler;
+	signalAction.sa_flags = SA_NOCLDSTOP;	/* No SA_RESTART: the signals interrupt poll(). */
+	sigemptyset(&signalAction.sa_mask);
+
+	sigaction(SIGTERM, &signalAction, NULL);
+	sigaction(SIGINT, &signalAction, NULL);
+	sigaction(SIGCHLD, &signalAction, NULL);
+	signal(SIGPIPE, SIG_IGN);	/* Clients may close their connection at any time. */
+
+	daemonListen();
+
+	printf("c Daemon listening on %s with %u workers, cache of %u formulas and %u MiB\n", daemonSocketPath, daemonWorkers, daemonCacheEntries, daemonCacheMemory);
+	fflush(stdout);
+
+
+	while (daemonStop == 0) {
+		daemonReap();
+
+		while (daemonRunning < daemonWorkers) {	/* The queued requests in the order of their arrival */
+			next = DAEMON_REQUESTS_MAX;
+
+			for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+				if (daemonRequestState[iRequests] == DAEMON_REQUEST_QUEUED && (next == DAEMON_REQUESTS_MAX || daemonRequestId[iRequests] < daemonRequestId[next]))
+					next = iRequests;
+			}
+
+			if (next == DAEMON_REQUESTS_MAX)
+				break;
+
+			daemonStart(next);
+		}
+
+
+		/* The descriptors and the next deadline */
+		pollFds[0].fd = daemonSocket;
+		pollFds[0].events = POLLIN;
+		numPollFds = 1;
+
+		deadline = 0;
+		hashing = false;
+
+		for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+			if (daemonRequestState[iRequests] == DAEMON_REQUEST_FREE || daemonRequestSignal[iRequests] == SIGKILL)
+				continue;
+
+			if (daemonRequestState[iRequests] == DAEMON_REQUEST_RECEIVING && daemonRequestInline[iRequests] == false)
+				hashing = true;
+
+			pollFds[numPollFds].fd = daemonRequestFd[iRequests];
+			pollFds[numPollFds].events = (daemonRequestEof[iRequests] == true || (daemonRequestState[iRequests] == DAEMON_REQUEST_RECEIVING && daemonRequestInline[iRequests] == false) ? 0 : POLLIN);	/* A hang-up is always reported. */
+			pollSlots[numPollFds] = iRequests;
+			numPollFds++;
+
+			if (daemonRequestDeadline[iRequests] > 0 && (deadline == 0 || daemonRequestDeadline[iRequests] < deadline))
+				deadline = daemonRequestDeadline[iRequests];
+		}
+
+		pollTimeout = (daemonRunning > 0 ? DAEMON_POLL : -1);	/* A SIGCHLD before poll() is noticed after DAEMON_POLL. */
+
+		if (deadline > 0 && (pollTimeout == -1 || (deadline - daemonNow()) * 1000 < pollTimeout))
+			pollTimeout = ((deadline - daemonNow()) > 0 ? (deadline - daemonNow()) * 1000 + 1 : 0);
+
+		if (hashing == true)	/* The instance files are hashed between the polls. */
+			pollTimeout = 0;
+
+		if (poll(pollFds, numPollFds, pollTimeout) == -1)
+			continue;	/* EINTR */
+
+
+		/* The connections of the requests */
+		for (iPollFds = 1; iPollFds < numPollFds; iPollFds++) {
+			iRequests = pollSlots[iPollFds];
+
+			if (daemonRequestState[iRequests] == DAEMON_REQUEST_FREE || pollFds[iPollFds].revents == 0)
+				continue;
+
+			if ((pollFds[iPollFds].revents & POLLIN) != 0 && daemonRequestState[iRequests] == DAEMON_REQUEST_LINE) {
+				daemonReceiveLine(iRequests, algoName, maxRestarts, randomSeed);
+			} else if ((pollFds[iPollFds].revents & POLLIN) != 0 && daemonRequestState[iRequests] == DAEMON_REQUEST_RECEIVING) {
+				daemonReceiveFormula(iRequests);
+			} else if ((pollFds[iPollFds].revents & POLLIN) != 0) {
+				length = read(daemonRequestFd[iRequests], buffer, sizeof(buffer) - 1);
+
+				if (length == 0) {	/* The client only closed its sending side. */
+					daemonRequestEof[iRequests] = true;
+				} else if (length > 0) {
+					buffer[length] = '\0';
+
+					if (strstr(buffer, "cancel") != NULL)
+						daemonCancel(iRequests, false);
+				}
+			}
+
+			if (daemonRequestState[iRequests] != DAEMON_REQUEST_FREE && (pollFds[iPollFds].revents & (POLLHUP | POLLERR)) != 0) {	/* The client is gone. */
+				if (daemonRequestState[iRequests] == DAEMON_REQUEST_RUNNING)
+					daemonCancel(iRequests, true);
+				else
+					daemonFree(iRequests);
+			}
+		}
+
+
+		/* The instance files */
+		for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+			if (daemonRequestState[iRequests] == DAEMON_REQUEST_RECEIVING && daemonRequestInline[iRequests] == false)
+				daemonReceiveFormula(iRequests);
+		}
+
+
+		/* The timeouts */
+		now = daemonNow();
+
+		for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+			if (daemonRequestState[iRequests] != DAEMON_REQUEST_FREE && daemonRequestDeadline[iRequests] > 0 && daemonRequestDeadline[iRequests] <= now) {
+				if (daemonRequestState[iRequests] == DAEMON_REQUEST_LINE || daemonRequestState[iRequests] == DAEMON_REQUEST_RECEIVING)
+					daemonReply(daemonRequestFd[iRequests], "The request didn't arrive in %d seconds!\n", DAEMON_RECEIVE_TIMEOUT);
+				else if (daemonRequestSignal[iRequests] == 0)
+					daemonReply(daemonRequestFd[iRequests], "c Request %u: timeout\n", daemonRequestId[iRequests]);
+
+				daemonCancel(iRequests, false);
+			}
+		}
+
+
+		if ((pollFds[0].revents & POLLIN) != 0)
+			daemonAccept();
+	}
+
+
+	/* Shutdown: the workers print their best solution candidates. */
+	close(daemonSocket);
+	unlink(daemonSocketPath);
+
+	for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+		if (daemonRequestState[iRequests] != DAEMON_REQUEST_FREE)
+			daemonCancel(iRequests, false);
+	}
+
+	stop = daemonNow() + DAEMON_GRACE;
+
+	while (daemonRunning > 0) {
+		daemonReap();
+
+		if (daemonNow() > stop) {
+			for (iRequests = 0; iRequests < DAEMON_REQUESTS_MAX; iRequests++) {
+				if (daemonRequestState[iRequests] == DAEMON_REQUEST_RUNNING)
+					daemonCancel(iRequests, true);
+			}
+		}
+
+		usleep(DAEMON_POLL * 1000 / 10);
+	}
+
+
+	/* Clean up! */
+	while (daemonCacheCount > 0)
+		daemonCacheRemove(0);
+}
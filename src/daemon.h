@@ -0,0 +1,72 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * daemon.h
+ *
+ *    This is the header file for daemon.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "solver.h"
+
+
+#define DAEMON_SOCKET_PATH_MAXLENGTH 107	/* The maximum length of the socket path (sun_path). */
+#define DAEMON_REQUESTS_MAX 1024			/* The maximum number of queued and running requests. */
+#define DAEMON_WORKERS_MAX 256				/* The maximum number of workers (see --workers). */
+#define DAEMON_CACHE_MAX 4096				/* The maximum number of cached formulas (see --cache). */
+#define DAEMON_CACHE_ENTRIES 256			/* The default number of cached formulas. */
+#define DAEMON_CACHE_MEMORY 4096			/* The default MiB of the cached formulas (see --cache-memory). */
+#define DAEMON_LINE_MAXLENGTH 4096			/* The maximum length of a request line. */
+#define DAEMON_RECEIVE_TIMEOUT 5			/* The seconds to receive the request line and the next bytes of an inline formula. */
+#define DAEMON_RECEIVE_CHUNKS 16			/* The buffers of an instance file which are hashed per loop of the daemon. */
+#define DAEMON_POLL 100						/* The milliseconds between two checks of the workers. */
+#define DAEMON_GRACE 1.0					/* The seconds a worker has to print its best candidate after a timeout or a cancellation. */
+#define DAEMON_BUFFER 65536					/* The bytes of the buffer for hashing and copying the formulas. */
+#define DAEMON_BACKLOG 64					/* The pending connections of the socket. */
+
+
+extern char daemonSocketPath[DAEMON_SOCKET_PATH_MAXLENGTH + 1];
+
+extern unsigned int daemonWorkers;
+
+extern unsigned int daemonCacheEntries;
+
+extern unsigned int daemonCacheMemory;
+
+
+void daemonRun(char algoName[], unsigned int maxRestarts, unsigned int randomSeed);
+
+
+#endif /* DAEMON_H */
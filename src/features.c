@@ -0,0 +1,228 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * features.c
+ *
+ * 	This file contains the instance features and the
+ *  automatic selection of the algorithm ("-a auto"). The
+ *  statistics are determined in one pass over the clauses
+ *  and the occurrences after the loading:
+ *  - the ratio of clauses to variables,
+ *  - the distribution of the clause lengths (mean,
+ *    maximum and the fraction of binary clauses) and
+ *  - the skew of the occurrences (the coefficient of
+ *    variation of the occurrences per variable).
+ *  If the statistics don't decide the selection, a probe
+ *  of a short local search measures the landscape: from a
+ *  random assignment every variable which improves the
+ *  assignment is flipped in FEATURES_PROBE_SWEEPS passes
+ *  over the variables. The fraction of clauses which are
+ *  still unsatisfied is high for rugged formulas. The probe has its own random
+ *  numbers, so the search of a seed is the same with
+ *  "-a auto" and the selected algorithm.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include "features.h"
+
+
+/* External variables for the features of the formula
+ * (see above). */
+unsigned int featuresNumVars;
+unsigned int featuresNumClauses;
+double featuresRatio;
+double featuresLengthMean;
+unsigned int featuresLengthMax;
+double featuresBinaryFraction;
+double featuresOccurrenceVariation;
+double featuresProbeResidual;
+
+
+/* External variable for the seconds of the feature
+ * extraction and the probe. */
+double featuresSeconds;
+
+
+/* featuresExtract()
+ *
+ * Determines the statistics of the clauses and the
+ * occurrences (see above). */
+void featuresExtract(int ***clauseList, int ***varList) {
+	unsigned int iClauseList;		/* Loop variable for the clauseList. */
+	unsigned int iVarList;			/* Loop variable for the varList. */
+	unsigned long long lengthSum = 0;			/* Sum of the clause lengths. */
+	unsigned int binaryClauses = 0;				/* Number of binary clauses. */
+	double occurrenceMean;						/* Mean number of occurrences of a variable. */
+	double occurrenceSquareSum = 0;				/* Sum of the squared occurrences per variable. */
+
+
+	featuresNumVars = (*varList)[0][0];
+	featuresNumClauses = (*clauseList)[0][0];
+	featuresLengthMax = 0;
+	featuresProbeResidual = -1;	/* The probe didn't run. */
+
+	for (iClauseList = 1; iClauseList <= featuresNumClauses; iClauseList++) {
+		lengthSum = lengthSum + (*clauseList)[iClauseList][0];
+		binaryClauses = binaryClauses + ((*clauseList)[iClauseList][0] == 2);
+
+		if ((*clauseList)[iClauseList][0] > featuresLengthMax)
+			featuresLengthMax = (*clauseList)[iClauseList][0];
+	}
+
+	for (iVarList = 1; iVarList <= featuresNumVars; iVarList++)
+		occurrenceSquareSum = occurrenceSquareSum + (double)(*varList)[iVarList][0] * (double)(*varList)[iVarList][0];
+
+	featuresRatio = (featuresNumVars > 0 ? (double)featuresNumClauses / featuresNumVars : 0);
+	featuresLengthMean = (featuresNumClauses > 0 ? (double)lengthSum / featuresNumClauses : 0);
+	featuresBinaryFraction = (featuresNumClauses > 0 ? (double)binaryClauses / featuresNumClauses : 0);
+
+	occurrenceMean = (featuresNumVars > 0 ? (double)lengthSum / featuresNumVars : 0);	/* Every literal is an occurrence. */
+	featuresOccurrenceVariation = (occurrenceMean > 0 ? sqrt(fmax(occurrenceSquareSum / featuresNumVars - occurrenceMean * occurrenceMean, 0)) / occurrenceMean : 0);
+}
+
+
+/* featuresProbe()
+ *
+ * Runs the probe (see above) and determines the fraction
+ * of the clauses which are unsatisfied after it. */
+void featuresProbe(int ***clauseList, int ***varList) {
+	unsigned char *assignment;		/* The assignment of the probe. */
+	int *trueLiterals;				/* The number of true literals of each clause. */
+	unsigned int random = FEATURES_PROBE_SEED;	/* State of the xorshift random numbers. */
+	unsigned int unsatisfiedClauses = 0;		/* Number of unsatisfied clauses after the probe. */
+	unsigned int iClauseList;		/* Loop variable for the clauseList. */
+	unsigned int iClauseListLit;	/* Loop variable for every literal in the clause. */
+	unsigned int iVarList;			/* Loop variable for the varList. */
+	unsigned int iVarListClause;	/* Loop variable for the clauses of the variable. */
+	unsigned int iSweeps;			/* Loop variable for the passes. */
+	int curLiteral;					/* Current literal of the loop. */
+	int curClause;					/* Current clause of the loop. */
+	int gain;						/* Number of clauses which the flip satisfies minus the number it unsatisfies. */
+
+
+	assignment = malloc(sizeof(unsigned char) * (featuresNumVars + 1));
+	if (assignment == NULL)
+		perror("malloc() for the probe assignment failed");
+
+	trueLiterals = calloc((featuresNumClauses + 1), sizeof(int));
+	if (trueLiterals == NULL)
+		perror("calloc() for the probe clause status failed");
+
+	for (iVarList = 1; iVarList <= featuresNumVars; iVarList++) {
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		assignment[iVarList] = random & 1;
+	}
+
+	for (iClauseList = 1; iClauseList <= featuresNumClauses; iClauseList++) {
+		for (iClauseListLit = 1; iClauseListLit <= (*clauseList)[iClauseList][0]; iClauseListLit++) {
+			curLiteral = (*clauseList)[iClauseList][iClauseListLit];
+			trueLiterals[iClauseList] = trueLiterals[iClauseList] + (curLiteral > 0 ? assignment[curLiteral] : (1 - assignment[(curLiteral * -1)]));
+		}
+	}
+
+	for (iSweeps = 0; iSweeps < FEATURES_PROBE_SWEEPS; iSweeps++) {
+		for (iVarList = 1; iVarList <= featuresNumVars; iVarList++) {	/* First improvement: every improving variable is flipped. */
+			gain = 0;
+
+			for (iVarListClause = 1; iVarListClause <= (*varList)[iVarList][0]; iVarListClause++) {
+				curClause = (*varList)[iVarList][iVarListClause];
+
+				if (trueLiterals[(curClause > 0 ? curClause : (curClause * -1))] == 0)
+					gain++;
+				else if (trueLiterals[(curClause > 0 ? curClause : (curClause * -1))] == 1 && (curClause > 0) == (assignment[iVarList] == 1))	/* Only this literal is true. */
+					gain--;
+			}
+
+			if (gain <= 0)
+				continue;
+
+			assignment[iVarList] = 1 - assignment[iVarList];
+
+			for (iVarListClause = 1; iVarListClause <= (*varList)[iVarList][0]; iVarListClause++) {
+				curClause = (*varList)[iVarList][iVarListClause];
+				trueLiterals[(curClause > 0 ? curClause : (curClause * -1))] += ((curClause > 0) == (assignment[iVarList] == 1) ? 1 : -1);
+			}
+		}
+	}
+
+	for (iClauseList = 1; iClauseList <= featuresNumClauses; iClauseList++)
+		unsatisfiedClauses = unsatisfiedClauses + (trueLiterals[iClauseList] == 0);
+
+	featuresProbeResidual = (featuresNumClauses > 0 ? (double)unsatisfiedClauses / featuresNumClauses : 0);
+
+
+	free(assignment);
+
+	free(trueLiterals);
+}
+
+
+/* featuresSelect()
+ *
+ * Determines the features of the formula and replaces the
+ * algorithm name "auto" with the algorithm of the first
+ * matching rule:
+ * 1. structured formulas (many binary clauses or a high
+ *    variation of the occurrences): ILS/SA,
+ * 2. uniform 3-SAT near the phase transition: RoTS with
+ *    the restart policy "luby" against the long runs,
+ * 3. rugged formulas (a high residual of the probe):
+ *    adaptive RoTS and
+ * 4. otherwise RoTS.
+ * Large formulas also get multi-flip steps. The restart
+ * policy and the multi-flip steps are only set, if they
+ * are not given. The features and the selection are
+ * printed in "c" lines. */
+void featuresSelect(int ***clauseList, int ***varList, char algoName[]) {
+	struct timespec start;			/* Begin of the extraction. */
+	struct timespec end;			/* End of the extraction. */
+
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	featuresExtract(&(*clauseList), &(*varList));
+
+	if (featuresBinaryFraction > FEATURES_BINARY_STRUCTURED || featuresOccurrenceVariation > FEATURES_VARIATION_STRUCTURED) {
+		strcpy(algoName, "ilssa");
+	} else if (featuresLengthMax == 3 && featuresLengthMean == 3 && featuresRatio >= FEATURES_RATIO_HARD_MIN && featuresRatio <= FEATURES_RATIO_HARD_MAX) {
+		strcpy(algoName, "rots");
+
+		if (restartPolicyGiven == false)
+			strcpy(restartPolicyName, "luby");
+	} else {
+		featuresProbe(&(*clauseList), &(*varList));	/* Only the remaining rules need the probe. */
+
+		if (featuresProbeResidual > FEATURES_RESIDUAL_RUGGED)
+			strcpy(algoName, "arots");
+		else
+			strcpy(algoName, "rots");
+	}
+
+	if (featuresNumVars > FEATURES_LARGE_VARS && multiflipGiven == false && clauseWeightList == NULL)
+		multiflipMax = FEATURES_MULTIFLIP;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	featuresSeconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+	printf("c Features (%.3f s): variables %u, clauses %u, ratio %.3f, clause length %.2f (max %u), binary clauses %.3f, occurrence variation %.3f, probe residual ", featuresSeconds, featuresNumVars, featuresNumClauses, featuresRatio, featuresLengthMean, featuresLengthMax, featuresBinaryFraction, featuresOccurrenceVariation);
+
+	if (featuresProbeResidual < 0)
+		printf("-\n");
+	else
+		printf("%.4f\n", featuresProbeResidual);
+
+	printf("c Auto selection: algorithm %s, restart policy %s, multi-flip %u\n", algoName, restartPolicyName, multiflipMax);
+}
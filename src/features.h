@@ -0,0 +1,72 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * features.h
+ *
+ *    This is the header file for features.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef FEATURES_H
+#define FEATURES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+
+#include "solver.h"
+
+
+#define FEATURES_PROBE_SEED 2463534242u		/* The seed of the assignment of the probe (independent of -r). */
+#define FEATURES_PROBE_SWEEPS 1				/* The passes over the variables of the probe. */
+
+/* The rule table of the automatic selection (see
+ * featuresSelect()). */
+#define FEATURES_RATIO_HARD_MIN 4.0			/* Uniform 3-SAT formulas with a ratio from here on are near the phase transition. */
+#define FEATURES_RATIO_HARD_MAX 4.4
+#define FEATURES_BINARY_STRUCTURED 0.1		/* Formulas with a higher fraction of binary clauses are structured. */
+#define FEATURES_VARIATION_STRUCTURED 0.5	/* Formulas with a higher variation of the occurrences are structured. */
+#define FEATURES_RESIDUAL_RUGGED 0.02		/* Formulas with a higher fraction of unsatisfied clauses after the probe are rugged. */
+#define FEATURES_LARGE_VARS 100000			/* Formulas with more variables use multi-flip steps. */
+#define FEATURES_MULTIFLIP 4096				/* The maximum number of variables of a multi-flip step for large formulas. */
+
+
+extern unsigned int featuresNumVars;
+
+extern unsigned int featuresNumClauses;
+
+extern double featuresRatio;
+
+extern double featuresLengthMean;
+
+extern unsigned int featuresLengthMax;
+
+extern double featuresBinaryFraction;
+
+extern double featuresOccurrenceVariation;
+
+extern double featuresProbeResidual;
+
+
+void featuresExtract(int ***clauseList, int ***varList);
+
+void featuresProbe(int ***clauseList, int ***varList);
+
+void featuresSelect(int ***clauseList, int ***varList, char algoName[]);
+
+
+#endif /* FEATURES_H */
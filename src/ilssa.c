@@ -50,8 +50,9 @@ short ilssaSimulatedAnnealing(int **flippedVariables, unsigned int solverIterati
 	unsigned int iVarList;			/* Loop variable for the varList */
 	unsigned int iTabuVariables;	/* Loop variable for ilssaTabuVariables */
 	bool isTabu;					/* Indicates, if the variable is tabu for this step. */
-	int quality;					/* The current quality of and possible solution candidate */
-	int highestQuality;				/* The highest quality of possible solution candidates */
+	long long quality;				/* The current quality of and possible solution candidate */
+	long long highestQuality;		/* The highest quality of possible solution candidates */
+	long long currentQuality;		/* The quality of the current solution candidate (the weight of the unsatisfied clauses in the weighted mode) */
 	double temperature;				/* The current temperature */
 	double probability;				/* The probability of the current solution candidate */
 	double random;					/* An random barrier for the probability */
@@ -66,7 +67,8 @@ short ilssaSimulatedAnnealing(int **flippedVariables, unsigned int solverIterati
 		return -1; /* A restart is needed */
 		
 	
-	highestQuality = (*clauseStatusList)[0];
+	currentQuality = (weightedScoreList != NULL ? weightedScoreList[0] : (*clauseStatusList)[0]);
+	highestQuality = currentQuality;
 
 	ilssaSolutionCandidates[0] = 0;
 
@@ -79,11 +81,14 @@ short ilssaSimulatedAnnealing(int **flippedVariables, unsigned int solverIterati
 			}
 		}
 		
-		if (isTabu == true)
+		if (isTabu == true || fixedVariables[iVarList] != 0)
 			continue;
 		
 
-		quality = (*clauseStatusList)[0] - (*varScoreList)[iVarList];
+		if (weightedScoreList != NULL)
+			quality = currentQuality - weightedScoreList[iVarList];
+		else
+			quality = currentQuality - (*varScoreList)[iVarList];
 		
 		/* Acceptance criterium */
 		if (quality < highestQuality) {
@@ -92,7 +97,7 @@ short ilssaSimulatedAnnealing(int **flippedVariables, unsigned int solverIterati
 			highestQuality = quality;
 		} else if(quality == highestQuality) {
 			/* Metropolis condition */
-			probability = (1.0 / (1.0 + exp(-1.0 * ((double)((*clauseStatusList)[0] - quality) / temperature))));
+			probability = (1.0 / (1.0 + exp(-1.0 * ((double)(currentQuality - quality) / temperature))));
 			random = (double)rand() / (double)RAND_MAX;
 			
 			if (random > probability) {
@@ -108,6 +113,7 @@ short ilssaSimulatedAnnealing(int **flippedVariables, unsigned int solverIterati
 		
 		(*flippedVariables)[0] = (*flippedVariables)[0] + 1;
 		(*flippedVariables)[(*flippedVariables)[0]] = flippedVariable;
+		TRACE_REASON((*flippedVariables)[0], (highestQuality < currentQuality ? TRACE_REASON_BEST : TRACE_REASON_ACCEPTANCE));
 
 		return 1;
 	}
@@ -157,11 +163,14 @@ short ilssaGetFlippedVariables(int **flippedVariables, unsigned int solverIterat
 	 * initialisation a subsidiary local search to find a
 	 * first local optima. For this, the solver iteration step
 	 * 0 can be seen as the "initialisation" step.*/
-	if (solverIteration > 0) {
+	perturbFlippedVariable = (solverIteration > 0 ? (rand() % (*varList)[0][0] + 1) : 0);
+
+	if (perturbFlippedVariable > 0 && fixedVariables[perturbFlippedVariable] == 0) {
 		(*flippedVariables)[0] = 1;
 		
-		perturbFlippedVariable = (rand() % (*varList)[0][0] + 1);
 		(*flippedVariables)[1] = perturbFlippedVariable;
+		TRACE_REASON(1, TRACE_REASON_PERTURBATION);
+		assignmentNoteFlip(perturbFlippedVariable, &(*solution));
 		(*solution)[perturbFlippedVariable] = 1 - (*solution)[perturbFlippedVariable];
 		
 		ilssaTabuVariables[0] = 1;
@@ -188,3 +197,22 @@ void ilssaCleanUp() {
 	
 	free(ilssaTabuVariables);
 }
+
+
+/* ilssaWriteCheckpoint()
+ *
+ * Writes the state of the ILS/SA algorithm (the tabu
+ * variable of the perturbation) into the checkpoint
+ * file. */
+void ilssaWriteCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointWriteData(ilssaTabuVariables, 2 * sizeof(int), checkpointFileHandle);
+}
+
+
+/* ilssaReadCheckpoint()
+ *
+ * Reads the state of the ILS/SA algorithm from the
+ * checkpoint file. */
+void ilssaReadCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointReadData(ilssaTabuVariables, 2 * sizeof(int), checkpointFileHandle);
+}
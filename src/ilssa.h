@@ -36,8 +36,14 @@
 
 void ilssaInitialisation(int ***varList);
 
+short ilssaSimulatedAnnealing(int **flippedVariables, unsigned int solverIteration, int ***varList, int **varScoreList, int **clauseStatusList);
+
 short ilssaGetFlippedVariables(int **flippedVariables, unsigned int solverIteration, unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList);
 
+void ilssaWriteCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
+void ilssaReadCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
 void ilssaCleanUp();
 
 
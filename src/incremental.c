@@ -0,0 +1,241 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * incremental.c
+ *	
+ * 	This file contains the incremental solving interface.
+ *  The formula stays loaded between the solving calls, it
+ *  can be extended by clauses and solved under temporary
+ *  assumptions. Each solving call starts from the solution
+ *  candidate of the previous call.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "incremental.h"
+
+
+/* External variables for the loaded formula.
+ * See solver() for the description of the lists. */
+int **incrementalClauseList;
+int **incrementalVarList;
+int *incrementalVarScoreList;
+int *incrementalClauseStatusList;
+int *incrementalFlippedVariables;
+
+/* External variable for the current solution
+ * candidate. After an successful incrementalSolve()
+ * call it contains the model. */
+unsigned short *incrementalSolution;
+
+
+/* Is there a solution candidate from a previous
+ * incrementalSolve() call to start from? */
+bool incrementalWarmStart = false;
+
+/* Are there two assumptions with complementary
+ * literals since the last release? */
+bool incrementalConflict = false;
+
+
+/* incrementalInitialisation()
+ *
+ * Loads the instance file or, if the path is NULL, an
+ * empty formula. */
+void incrementalInitialisation(char instanceFilePath[]) {
+	if (instanceFilePath != NULL)
+		readInstanceFile(instanceFilePath, &incrementalClauseList, &incrementalVarList, &incrementalVarScoreList, &incrementalSolution, &incrementalClauseStatusList, &incrementalFlippedVariables);
+	else
+		initialiseFormula(&incrementalClauseList, &incrementalVarList, &incrementalVarScoreList, &incrementalSolution, &incrementalClauseStatusList, &incrementalFlippedVariables);
+
+	incrementalWarmStart = false;
+	incrementalConflict = false;
+}
+
+
+/* incrementalAddClause()
+ *
+ * Adds a clause to the loaded formula. The index 0 of
+ * literals contains the number of literals. Variables
+ * which are not known so far are added to the formula.
+ * Duplicated literals are removed and clauses which are
+ * always satisfied are skipped (see normaliseClause()). */
+void incrementalAddClause(int literals[]) {
+	unsigned int iLiterals;	/* Loop variable for literals. */
+	unsigned int maxVar = 0;	/* The highest variable in the clause. */
+
+
+	if (normaliseClause(literals) == false)
+		return;
+
+	for (iLiterals = 1; iLiterals <= literals[0]; iLiterals++) {
+		if (literals[iLiterals] > 0 && literals[iLiterals] > maxVar)
+			maxVar = literals[iLiterals];
+		else if (literals[iLiterals] < 0 && (literals[iLiterals] * -1) > maxVar)
+			maxVar = literals[iLiterals] * -1;
+	}
+
+	addVariables(maxVar, &incrementalVarList, &incrementalVarScoreList, &incrementalSolution, &incrementalFlippedVariables);
+
+	addClause(literals, &incrementalClauseList, &incrementalVarList, &incrementalSolution, &incrementalClauseStatusList);
+}
+
+
+/* incrementalAssume()
+ *
+ * Assumes the literal to be true for the next solving
+ * calls until incrementalReleaseAssumptions() is called.
+ * It returns false if the complementary literal is already
+ * assumed. Then the next solving calls return "-1". */
+bool incrementalAssume(int literal) {
+	unsigned int var = (literal > 0 ? literal : (literal * -1));	/* Variable of the literal. */
+
+
+	addVariables(var, &incrementalVarList, &incrementalVarScoreList, &incrementalSolution, &incrementalFlippedVariables);
+
+	if (fixedVariables[var] != 0 && fixedVariables[var] != (literal > 0 ? 2 : 1)) {
+		incrementalConflict = true;
+		return false;
+	}
+
+	fixVariable(literal, &incrementalVarList, &incrementalSolution, &incrementalClauseStatusList, &incrementalFlippedVariables);
+
+	return true;
+}
+
+
+/* incrementalReleaseAssumptions()
+ *
+ * Removes all assumptions. */
+void incrementalReleaseAssumptions() {
+	releaseVariables(&incrementalVarList);
+
+	incrementalConflict = false;
+}
+
+
+/* incrementalSolve()
+ *
+ * Solves the loaded formula under the current assumptions.
+ * Except for the first call, the search starts from the
+ * solution candidate of the previous call.
+ * See solverSearch() for the returning value, "-1" is
+ * returned for conflicting assumptions. */
+int incrementalSolve(char algoName[], unsigned int maxRestarts) {
+	int solutionQuality;	/* Return value */
+
+
+	if (incrementalConflict == true)
+		return -1;
+
+	if (strcmp(algoName, "auto") == 0) {	/* The algorithm is selected by the features of the formula of the first call. */
+		featuresSelect(&incrementalClauseList, &incrementalVarList, algoName);
+	}
+
+	solutionQuality = solverSearch(&incrementalSolution, &incrementalClauseList, &incrementalVarList, &incrementalVarScoreList, &incrementalClauseStatusList, &incrementalFlippedVariables, algoName, maxRestarts, incrementalWarmStart);
+
+	incrementalWarmStart = true;
+
+	return solutionQuality;
+}
+
+
+/* incrementalCleanUp()
+ *
+ * Deallocate the memory of the loaded formula. */
+void incrementalCleanUp() {
+	solverCleanUp(&incrementalClauseList, &incrementalVarList, &incrementalVarScoreList, &incrementalClauseStatusList, &incrementalFlippedVariables);
+
+	free(incrementalSolution);
+}
+
+
+/* incrementalRun()
+ *
+ * Runs the incremental solving on an file in the iCNF
+ * format: After an optional "p inccnf" line, the clause
+ * lines are added to the formula and each line
+ * "a <lit1> ... <litn> 0" solves the formula under the
+ * given assumptions. The result of each solving call is
+ * printed directly. */
+void incrementalRun(char instanceFilePath[], char algoName[], unsigned int maxRestarts) {
+	FILE *instanceFileHandle;	/* File hande for the instance file. */
+	int curChar;				/* Current character of the instance file. */
+	int litTmp;					/* Temporal variable for one literal. */
+	bool isAssumption = false;	/* Is the current line an assumption line? */
+	int solutionQuality;		/* Result of the current solving call. */
+
+	/* Buffer for the literals of the current line. The index
+	 * 0 contains the number of literals. */
+	int *literalsBuf = growList(NULL, 0, 1, sizeof(int));
+
+
+	instanceFileHandle = fopen(instanceFilePath, "r");
+
+	if (instanceFileHandle == NULL)
+		pExit("Can't open instance file!\n");
+
+	incrementalInitialisation(NULL);
+
+	while ((curChar = fgetc(instanceFileHandle)) != EOF) {
+		if (curChar == 'c' || curChar == 'p') {					/* Comment or the "p inccnf" line */
+			while (curChar != '\n' && curChar != EOF)
+				curChar = fgetc(instanceFileHandle);
+		} else if (curChar == 'a') {							/* Assumption line */
+			isAssumption = true;
+		} else if (curChar == '-' || (curChar >= '0' && curChar <= '9')) {
+			ungetc(curChar, instanceFileHandle);
+
+			if (fscanf(instanceFileHandle, "%d", &litTmp) != 1)
+				pExit("Can't read the literal after the %d. literal of a line!\n", literalsBuf[0]);
+
+			if (litTmp != 0) {
+				literalsBuf = growList(literalsBuf, (literalsBuf[0] + 1), (literalsBuf[0] + 2), sizeof(int));
+				literalsBuf[0] = literalsBuf[0] + 1;
+				literalsBuf[literalsBuf[0]] = litTmp;
+				continue;
+			}
+
+			if (isAssumption == true) {	/* Solve under the assumptions */
+				for (litTmp = 1; litTmp <= literalsBuf[0]; litTmp++)
+					incrementalAssume(literalsBuf[litTmp]);
+
+				solutionQuality = incrementalSolve(algoName, maxRestarts);
+
+				if (solutionQuality == 0)
+					printSolution(incrementalSolution);
+				else
+					printf("s UNKNOWN\n");
+
+				fflush(stdout);
+
+				incrementalReleaseAssumptions();
+			} else {
+				incrementalAddClause(literalsBuf);
+			}
+
+			literalsBuf[0] = 0;
+			isAssumption = false;
+		} else if (curChar != ' ' && curChar != '\t' && curChar != '\r' && curChar != '\n') {
+			pExit("Unexpected character \"%c\" in the iCNF file!\n", curChar);
+		}
+	}
+
+	fclose(instanceFileHandle);
+
+
+	/* Clean up! */
+	free(literalsBuf);
+
+	incrementalCleanUp();
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * incremental.h
+ *
+ *    This is the header file for incremental.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+
+
+
+extern unsigned short *incrementalSolution;
+
+
+void incrementalInitialisation(char instanceFilePath[]);
+
+void incrementalAddClause(int literals[]);
+
+bool incrementalAssume(int literal);
+
+void incrementalReleaseAssumptions();
+
+int incrementalSolve(char algoName[], unsigned int maxRestarts);
+
+void incrementalCleanUp();
+
+void incrementalRun(char instanceFilePath[], char algoName[], unsigned int maxRestarts);
+
+
+#endif /* INCREMENTAL_H */
\ No newline at end of file
@@ -0,0 +1,288 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * ksat.c
+ *	
+ * 	This file contains the specialised kernels for formulas
+ *  whose clauses have all the same length k (k-SAT). The
+ *  literals are stored with a fixed stride of k, the
+ *  clause evaluation is unrolled and the scores of the
+ *  variables are updated incrementally, so no full
+ *  updateVarScoreList() is needed after a flip.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "ksat.h"
+
+
+/* External variable for the clause length of the
+ * formula. It is 0 if the clauses have different
+ * lengths or there are no kernels for this length,
+ * then the generic functions of solver.c are used. */
+unsigned int ksatLength = 0;
+
+
+/* External variable for the literals of all clauses.
+ * The literals of the clause c are stored at the
+ * indices (c - 1) * ksatLength to c * ksatLength - 1.
+ * Each literal is stored as (variable << 1) | negation,
+ * so the literal value is solution[variable] ^ negation
+ * without a sign branch. */
+unsigned int *ksatLiterals = NULL;
+
+
+/* External variable for the number of clauses. */
+unsigned int ksatNumClauses;
+
+
+/* External variable for the varScoreList of the
+ * search, which is updated by the kernels. */
+int *ksatScoreList;
+
+
+/* Value of the I-th literal of the current clause. */
+#define KSAT_TRUE(I) ((*solution)[lits[(I)] >> 1] ^ (lits[(I)] & 1))
+
+/* Variable of the I-th literal of the current clause. */
+#define KSAT_VAR(I) (lits[(I)] >> 1)
+
+
+/* Terms for the unrolled clause evaluation. */
+#define KSAT_STATUS_TERM(I) + KSAT_TRUE(I)
+#define KSAT_SCORE_TERM(I) ksatScoreList[KSAT_VAR(I)] += unsatisfied - (critical * KSAT_TRUE(I));
+#define KSAT_ADD_ONE_TERM(I) ksatScoreList[KSAT_VAR(I)]++;
+#define KSAT_SUB_ONE_TERM(I) ksatScoreList[KSAT_VAR(I)]--;
+#define KSAT_ADD_TRUE_TERM(I) ksatScoreList[KSAT_VAR(I)] += KSAT_TRUE(I);
+#define KSAT_SUB_TRUE_TERM(I) ksatScoreList[KSAT_VAR(I)] -= KSAT_TRUE(I);
+
+
+/* KSAT_KERNELS()
+ *
+ * Defines the kernels for the clause length K:
+ * - ksatRebuildClauseStatusListK() determines the
+ *   clauseStatusList from scratch,
+ * - ksatRebuildVarScoreListK() determines the scores from
+ *   scratch and
+ * - ksatUpdateFlippedVariablesK() updates the
+ *   clauseStatusList and the scores for the flipped
+ *   variables first to last and returns the change of the
+ *   number of unsatisfied clauses. Only the clauses whose
+ *   number of true literals becomes 0, 1 or 2 change any
+ *   score. */
+#define KSAT_KERNELS(K) \
+void ksatRebuildClauseStatusList##K(unsigned short **solution, int **clauseStatusList) { \
+	unsigned int iClauseList;				/* Loop variable for the clauses. */ \
+	unsigned int unsatisfiedClauses = 0;	/* Number of unsatisfied clauses. */ \
+	unsigned int *lits;						/* Literals of the current clause. */ \
+	int trueLiterals;						/* Number of true literals of the current clause. */ \
+	\
+	for (iClauseList = 1; iClauseList <= ksatNumClauses; iClauseList++) { \
+		lits = &ksatLiterals[(iClauseList - 1) * K]; \
+		trueLiterals = 0 KSAT_REPEAT_##K(KSAT_STATUS_TERM); \
+		(*clauseStatusList)[iClauseList] = trueLiterals; \
+		unsatisfiedClauses = unsatisfiedClauses + (trueLiterals == 0); \
+	} \
+	\
+	(*clauseStatusList)[0] = unsatisfiedClauses; \
+} \
+\
+void ksatRebuildVarScoreList##K(unsigned short **solution, int **clauseStatusList) { \
+	unsigned int iClauseList;	/* Loop variable for the clauses. */ \
+	unsigned int *lits;			/* Literals of the current clause. */ \
+	int unsatisfied;			/* 1 if the current clause is unsatisfied. */ \
+	int critical;				/* 1 if the current clause has exactly one true literal. */ \
+	\
+	for (iClauseList = 1; iClauseList <= ksatNumClauses; iClauseList++) { \
+		lits = &ksatLiterals[(iClauseList - 1) * K]; \
+		unsatisfied = ((*clauseStatusList)[iClauseList] == 0); \
+		critical = ((*clauseStatusList)[iClauseList] == 1); \
+		KSAT_REPEAT_##K(KSAT_SCORE_TERM) \
+	} \
+} \
+\
+int ksatUpdateFlippedVariables##K(int **flippedVariables, unsigned int first, unsigned int last, unsigned short **solution, int ***varList, int **clauseStatusList) { \
+	unsigned int iFlippedVariables;		/* Loop variable for flippedVariables. */ \
+	unsigned int iVarListClause;		/* Loop variable for varList. */ \
+	unsigned int var;					/* Current flipped variable. */ \
+	unsigned short varValue;			/* Current variable status. */ \
+	int *occurrences;					/* Clauses which contain the current variable. */ \
+	int curClause;						/* Current selected clause in the iVarListClause loop. */ \
+	unsigned int clause;				/* Number of curClause. */ \
+	int isTrue;							/* 1 if the literal is true after the flip. */ \
+	int oldClauseStatus;				/* Number of true literals before the flip. */ \
+	int unsatisfiedClauses = 0;			/* Change of the number of unsatisfied clauses. */ \
+	unsigned int *lits;					/* Literals of the current clause. */ \
+	\
+	for (iFlippedVariables = first; iFlippedVariables <= last; iFlippedVariables++) /* The variables are applied one after another. */ \
+		(*solution)[(*flippedVariables)[iFlippedVariables]] ^= 1; \
+	\
+	for (iFlippedVariables = first; iFlippedVariables <= last; iFlippedVariables++) { \
+		var = (*flippedVariables)[iFlippedVariables]; \
+		(*solution)[var] ^= 1; \
+		varValue = (*solution)[var]; \
+		occurrences = (*varList)[var]; \
+		\
+		for (iVarListClause = 1; iVarListClause <= occurrences[0]; iVarListClause++) { \
+			curClause = occurrences[iVarListClause]; \
+			clause = (curClause > 0 ? curClause : (curClause * -1)); \
+			isTrue = varValue ^ (curClause < 0); \
+			oldClauseStatus = (*clauseStatusList)[clause]; \
+			(*clauseStatusList)[clause] = oldClauseStatus + (2 * isTrue) - 1; \
+			lits = &ksatLiterals[(clause - 1) * K]; \
+			\
+			if (isTrue == 1) { \
+				if (oldClauseStatus == 0) {			/* The clause becomes satisfied by this variable only. */ \
+					unsatisfiedClauses--; \
+					KSAT_REPEAT_##K(KSAT_SUB_ONE_TERM) \
+					ksatScoreList[var]--; \
+				} else if (oldClauseStatus == 1) {	/* The other true literal is not critical anymore. */ \
+					KSAT_REPEAT_##K(KSAT_ADD_TRUE_TERM) \
+					ksatScoreList[var]--; \
+				} \
+			} else { \
+				if (oldClauseStatus == 1) {			/* The clause becomes unsatisfied. */ \
+					unsatisfiedClauses++; \
+					KSAT_REPEAT_##K(KSAT_ADD_ONE_TERM) \
+					ksatScoreList[var]++; \
+				} else if (oldClauseStatus == 2) {	/* The remaining true literal becomes critical. */ \
+					KSAT_REPEAT_##K(KSAT_SUB_TRUE_TERM) \
+				} \
+			} \
+		} \
+	} \
+	\
+	return unsatisfiedClauses; \
+}
+
+
+KSAT_KERNELS(3)
+KSAT_KERNELS(4)
+KSAT_KERNELS(5)
+KSAT_KERNELS(7)
+
+
+/* ksatInitialisation()
+ * 
+ * Checks if all clauses have the same length with
+ * specialised kernels and stores the literals with a fixed
+ * stride. Otherwise ksatLength stays 0. The weighted mode
+ * always uses the generic functions. */
+void ksatInitialisation(int ***clauseList, int ***varList, int **varScoreList) {
+	unsigned int iClauseList;		/* Loop variable for the clauseList. */
+	unsigned int iClauseListLit;	/* Loop variable for the literals of a clause. */
+	int curLiteral;					/* Current literal of the loop. */
+	unsigned int length;			/* Length of the first clause. */
+
+
+	ksatLength = 0;
+
+	if (clauseWeightList != NULL || (*clauseList)[0][0] == 0)
+		return;
+
+	length = (*clauseList)[1][0];
+
+	if (length != 3 && length != 4 && length != 5 && length != 7)
+		return;
+
+	for (iClauseList = 2; iClauseList <= (*clauseList)[0][0]; iClauseList++) {
+		if ((*clauseList)[iClauseList][0] != length)
+			return; /* Mixed formula */
+	}
+
+	ksatNumClauses = (*clauseList)[0][0];
+
+	ksatLiterals = malloc(ksatNumClauses * length * sizeof(unsigned int));
+	if (ksatLiterals == NULL) {
+		perror("malloc() for ksatLiterals failed");
+		return;
+	}
+
+	for (iClauseList = 1; iClauseList <= ksatNumClauses; iClauseList++) {
+		for (iClauseListLit = 1; iClauseListLit <= length; iClauseListLit++) {
+			curLiteral = (*clauseList)[iClauseList][iClauseListLit];
+			ksatLiterals[((iClauseList - 1) * length) + (iClauseListLit - 1)] = (curLiteral > 0 ? ((unsigned int)curLiteral << 1) : (((unsigned int)(curLiteral * -1) << 1) | 1));
+		}
+	}
+
+	ksatScoreList = *varScoreList;
+	ksatLength = length;
+}
+
+
+/* ksatRebuildClauseStatusList()
+ *
+ * The k-SAT version of rebuildClauseStatusList(). */
+void ksatRebuildClauseStatusList(unsigned short **solution, int **clauseStatusList) {
+	switch (ksatLength) {
+		case 3: ksatRebuildClauseStatusList3(&(*solution), &(*clauseStatusList)); break;
+		case 4: ksatRebuildClauseStatusList4(&(*solution), &(*clauseStatusList)); break;
+		case 5: ksatRebuildClauseStatusList5(&(*solution), &(*clauseStatusList)); break;
+		case 7: ksatRebuildClauseStatusList7(&(*solution), &(*clauseStatusList)); break;
+	}
+}
+
+
+/* ksatRebuildVarScoreList()
+ *
+ * The k-SAT version of updateVarScoreList(). */
+void ksatRebuildVarScoreList(unsigned short **solution, int ***varList, int **clauseStatusList) {
+	memset(ksatScoreList, 0, sizeof(int) * ((*varList)[0][0] + 1));
+
+	switch (ksatLength) {
+		case 3: ksatRebuildVarScoreList3(&(*solution), &(*clauseStatusList)); break;
+		case 4: ksatRebuildVarScoreList4(&(*solution), &(*clauseStatusList)); break;
+		case 5: ksatRebuildVarScoreList5(&(*solution), &(*clauseStatusList)); break;
+		case 7: ksatRebuildVarScoreList7(&(*solution), &(*clauseStatusList)); break;
+	}
+}
+
+
+/* ksatUpdateClauseStatusList()
+ *
+ * The k-SAT version of updateClauseStatusList(), which
+ * also updates the scores. */
+void ksatUpdateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList) {
+	(*clauseStatusList)[0] = (*clauseStatusList)[0] + ksatUpdateFlippedVariables(&(*flippedVariables), 1, (*flippedVariables)[0], &(*solution), &(*varList), &(*clauseStatusList));
+}
+
+
+/* ksatUpdateFlippedVariables()
+ *
+ * Updates the clauseStatusList and the scores for the
+ * flipped variables first to last (see KSAT_KERNELS())
+ * and returns the change of the number of unsatisfied
+ * clauses. Variables without common clauses and common
+ * neighbours can be updated by different threads. */
+int ksatUpdateFlippedVariables(int **flippedVariables, unsigned int first, unsigned int last, unsigned short **solution, int ***varList, int **clauseStatusList) {
+	switch (ksatLength) {
+		case 3: return ksatUpdateFlippedVariables3(&(*flippedVariables), first, last, &(*solution), &(*varList), &(*clauseStatusList));
+		case 4: return ksatUpdateFlippedVariables4(&(*flippedVariables), first, last, &(*solution), &(*varList), &(*clauseStatusList));
+		case 5: return ksatUpdateFlippedVariables5(&(*flippedVariables), first, last, &(*solution), &(*varList), &(*clauseStatusList));
+		case 7: return ksatUpdateFlippedVariables7(&(*flippedVariables), first, last, &(*solution), &(*varList), &(*clauseStatusList));
+	}
+
+	return 0;
+}
+
+
+/* ksatCleanUp()
+ *
+ * Deallocate memory which was used by the k-SAT kernels
+ * and switch back to the generic functions. */
+void ksatCleanUp() {
+	free(ksatLiterals);
+	ksatLiterals = NULL;
+
+	ksatLength = 0;
+}
\ No newline at end of file
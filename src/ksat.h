@@ -0,0 +1,59 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * ksat.h
+ *
+ *    This is the header file for ksat.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef KSAT_H
+#define KSAT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+
+/* Repeats the macro M for every literal index of a
+ * clause with the given length. These macros unroll
+ * the clause evaluation of the k-SAT kernels. */
+#define KSAT_REPEAT_3(M) M(0) M(1) M(2)
+#define KSAT_REPEAT_4(M) KSAT_REPEAT_3(M) M(3)
+#define KSAT_REPEAT_5(M) KSAT_REPEAT_4(M) M(4)
+#define KSAT_REPEAT_7(M) KSAT_REPEAT_5(M) M(5) M(6)
+
+
+extern unsigned int ksatLength;
+
+extern unsigned int *ksatLiterals;
+
+
+void ksatInitialisation(int ***clauseList, int ***varList, int **varScoreList);
+
+void ksatRebuildClauseStatusList(unsigned short **solution, int **clauseStatusList);
+
+void ksatRebuildVarScoreList(unsigned short **solution, int ***varList, int **clauseStatusList);
+
+void ksatUpdateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList);
+
+int ksatUpdateFlippedVariables(int **flippedVariables, unsigned int first, unsigned int last, unsigned short **solution, int ***varList, int **clauseStatusList);
+
+void ksatCleanUp();
+
+
+#endif /* KSAT_H */
\ No newline at end of file
@@ -0,0 +1,273 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * models.c
+ *	
+ * 	This file contains the enumeration of diverse models
+ *  (see --models). The formula is loaded once and after each
+ *  model the search continues from it. Before, the model is
+ *  blocked with a minimum Hamming distance d: the free
+ *  variables are split randomly into d groups and each group
+ *  gets a clause which is only unsatisfied by the values of
+ *  the model, so every later model differs in at least one
+ *  variable of each group. Each model is printed as soon as
+ *  it is found.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "models.h"
+
+
+/* External variables for the options: the number of models
+ * (0 = disabled) and the minimum Hamming distance between
+ * two models (0 = the default, see MODELS_DISTANCE_FRACTION). */
+unsigned int modelsMax = 0;
+unsigned int modelsDistance = 0;
+
+/* External variable for the number of printed models. */
+unsigned int modelsFound = 0;
+
+
+/* External variable for the found models as bitsets of
+ * modelsWords words each, the variable v is the bit
+ * (v - 1) % 64 of the word (v - 1) / 64. */
+unsigned long long *modelsList = NULL;
+unsigned int modelsWords = 0;
+
+/* External variable for the variables which are not fixed.
+ * The index 0 contains the number of variables. */
+unsigned int *modelsFreeVariables = NULL;
+
+/* External variables for the flips and the restarts of the
+ * searches before the current one. */
+unsigned long long modelsFlips = 0;
+unsigned int modelsRestarts = 0;
+
+
+/* modelsBlock()
+ *
+ * Adds the clauses which keep the next models at least
+ * modelsDistance variables away from the current one (see
+ * above). */
+void modelsBlock(unsigned short **solution, int ***clauseList, int ***varList, int **clauseStatusList) {
+	unsigned int numFree = modelsFreeVariables[0];	/* Number of free variables. */
+	unsigned int iFree;								/* Loop variable for the free variables. */
+	unsigned int iGroups;							/* Loop variable for the groups. */
+	unsigned int randomIndex;						/* Index for the shuffle. */
+	unsigned int var;								/* Current variable. */
+
+	/* Buffer for the literals of a clause. The index 0
+	 * contains the number of literals. */
+	int *literals = malloc(((numFree / modelsDistance) + 2) * sizeof(int));
+	if (literals == NULL)
+		perror("malloc() for the literals of the models failed");
+
+
+	for (iFree = numFree; iFree > 1; iFree--) {	/* A new partition for every model */
+		randomIndex = rand() % iFree + 1;
+
+		var = modelsFreeVariables[iFree];
+		modelsFreeVariables[iFree] = modelsFreeVariables[randomIndex];
+		modelsFreeVariables[randomIndex] = var;
+	}
+
+	for (iGroups = 1; iGroups <= modelsDistance; iGroups++) {
+		literals[0] = 0;
+
+		for (iFree = iGroups; iFree <= numFree; iFree = iFree + modelsDistance) {
+			var = modelsFreeVariables[iFree];
+
+			literals[0] = literals[0] + 1;
+			literals[literals[0]] = ((*solution)[var] == 1 ? ((int)var * -1) : (int)var);
+		}
+
+		addClause(literals, &(*clauseList), &(*varList), &(*solution), &(*clauseStatusList));
+	}
+
+	free(literals);
+}
+
+
+/* modelsStore()
+ *
+ * Stores the current model and returns its Hamming distance
+ * to the nearest earlier model (0 for the first one). */
+unsigned int modelsStore(unsigned short **solution, int ***varList) {
+	unsigned long long *model;			/* The bitset of the current model. */
+	unsigned int nearestDistance = 0;	/* Return value */
+	unsigned int distance;				/* Distance to the current earlier model. */
+	unsigned int iModels;				/* Loop variable for the earlier models. */
+	unsigned int iWords;				/* Loop variable for the words. */
+	unsigned int iVarList;				/* Loop variable for the variables. */
+
+
+	modelsList = growList(modelsList, (modelsFound * modelsWords), ((modelsFound + 1) * modelsWords), sizeof(unsigned long long));
+	model = &modelsList[modelsFound * modelsWords];
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {
+		if ((*solution)[iVarList] == 1)
+			model[(iVarList - 1) / 64] |= 1ULL << ((iVarList - 1) % 64);
+	}
+
+	for (iModels = 0; iModels < modelsFound; iModels++) {
+		distance = 0;
+
+		for (iWords = 0; iWords < modelsWords; iWords++)
+			distance = distance + __builtin_popcountll(model[iWords] ^ modelsList[iModels * modelsWords + iWords]);
+
+		if (iModels == 0 || distance < nearestDistance)
+			nearestDistance = distance;
+	}
+
+	modelsFound = modelsFound + 1;
+
+	return nearestDistance;
+}
+
+
+/* modelsFinish()
+ *
+ * Prints the number of the found models and appends the
+ * result record. The solution quality is the one of the
+ * last search. Also used after SIGTERM, if there are
+ * already models. */
+void modelsFinish(int solutionQuality) {
+	solverFlips = modelsFlips + solverFlips;
+	solverRestarts = modelsRestarts + solverRestarts;
+
+	printf("c Models: %u of %u\n", modelsFound, modelsMax);
+
+	if (modelsFound == 0)
+		printf("s UNKNOWN\n");
+
+	outputResult((modelsFound > 0 ? "SATISFIABLE" : "UNKNOWN"), (modelsFound > 0 ? 0 : solutionQuality), -1);
+}
+
+
+/* modelsRun()
+ *
+ * Searches up to modelsMax models of the instance file. Each
+ * search continues from the previous model with the
+ * clauses of modelsBlock(). The enumeration ends, if a
+ * search finds no model within the maximum number of
+ * restarts. */
+void modelsRun(char instanceFilePath[], char algoName[], unsigned int maxRestarts) {
+	int **clauseList;				/* See solver() for the description of the lists. */
+	int **varList;
+	int *varScoreList;
+	int *clauseStatusList;
+	int *flippedVariables;
+	unsigned short *solution;
+
+	unsigned short *printedSolution;	/* The model in the original numbering (see reorderRestoreSolution()). */
+	int solutionQuality;				/* Result of the current search. */
+	unsigned int distance;				/* Distance of the current model to the nearest earlier model. */
+	unsigned int iVarList;				/* Loop variable for the variables. */
+
+
+	PROFILE_START(PROFILE_PHASE_LOAD);
+
+	readInstanceFile(instanceFilePath, &clauseList, &varList, &varScoreList, &solution, &clauseStatusList, &flippedVariables);
+
+	if (weightedMode == true)
+		pExit("The enumeration of models (--models) doesn't support \"p wcnf\" instances.\n");
+
+	if (strcmp(algoName, "auto") == 0) {	/* The algorithm is selected by the features of the formula. */
+		featuresSelect(&clauseList, &varList, algoName);
+	}
+
+	if (reorderEnabled == true)
+		reorderFormula(&clauseList, &varList, &solution);
+
+	PROFILE_STOP(PROFILE_PHASE_LOAD);
+
+
+	modelsWords = (varList[0][0] + 63) / 64;
+
+	modelsFreeVariables = growList(NULL, 0, (varList[0][0] + 1), sizeof(unsigned int));
+
+	for (iVarList = 1; iVarList <= varList[0][0]; iVarList++) {
+		if (fixedVariables[iVarList] == 0) {
+			modelsFreeVariables[0] = modelsFreeVariables[0] + 1;
+			modelsFreeVariables[modelsFreeVariables[0]] = iVarList;
+		}
+	}
+
+	if (modelsDistance == 0)
+		modelsDistance = modelsFreeVariables[0] / MODELS_DISTANCE_FRACTION;
+
+	if (modelsDistance == 0)
+		modelsDistance = 1;
+
+	if (modelsDistance > modelsFreeVariables[0])
+		modelsDistance = modelsFreeVariables[0];
+
+	printf("c Models: up to %u with a minimum Hamming distance of %u\n", modelsMax, modelsDistance);
+
+
+	while (true) {
+		solutionQuality = solverSearch(&solution, &clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables, algoName, maxRestarts, (modelsFound > 0));
+
+		if (solutionQuality != 0)
+			break;
+
+		distance = modelsStore(&solution, &varList);
+
+		if (modelsFound == 1) {
+			printf("s SATISFIABLE\n");
+			printf("c Model 1\n");
+		} else {
+			printf("c Model %u: Hamming distance %u to the nearest earlier model\n", modelsFound, distance);
+		}
+
+		if (reorderEnabled == true) {
+			printedSolution = growList(NULL, 0, (varList[0][0] + 1), sizeof(unsigned short));
+			memcpy(printedSolution, solution, (varList[0][0] + 1) * sizeof(unsigned short));
+
+			reorderRestoreSolution(&printedSolution);
+
+			printModel(printedSolution);
+
+			free(printedSolution);
+		} else {
+			printModel(solution);
+		}
+
+		fflush(stdout);
+
+		if (modelsFound == modelsMax || modelsDistance == 0)
+			break; /* All models are found or there is no free variable left. */
+
+		modelsFlips = modelsFlips + solverFlips;
+		modelsRestarts = modelsRestarts + solverRestarts;
+
+		modelsBlock(&solution, &clauseList, &varList, &clauseStatusList);
+	}
+
+	modelsFinish(solutionQuality);
+
+
+	/* Clean up! */
+	solverCleanUp(&clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables);
+
+	reorderCleanUp();
+
+	free(solution);
+
+	free(modelsList);
+	modelsList = NULL;
+
+	free(modelsFreeVariables);
+	modelsFreeVariables = NULL;
+}
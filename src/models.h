@@ -0,0 +1,52 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * models.h
+ *
+ *    This is the header file for models.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef MODELS_H
+#define MODELS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+
+#define MODELS_MAX 1000000			/* The maximum number of models (see --models). */
+#define MODELS_DISTANCE_FRACTION 20	/* The default minimum distance is the number of free variables divided by this. */
+
+
+extern unsigned int modelsMax;
+
+extern unsigned int modelsDistance;
+
+extern unsigned int modelsFound;
+
+
+void modelsBlock(unsigned short **solution, int ***clauseList, int ***varList, int **clauseStatusList);
+
+unsigned int modelsStore(unsigned short **solution, int ***varList);
+
+void modelsFinish(int solutionQuality);
+
+void modelsRun(char instanceFilePath[], char algoName[], unsigned int maxRestarts);
+
+
+#endif /* MODELS_H */
@@ -0,0 +1,325 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * multiflip.c
+ *
+ * 	This file contains the multi-flip steps. Early in a try
+ *  many variables improve the solution candidate, but the
+ *  algorithms flip only one of them per step. A multi-flip
+ *  step selects up to multiflipMax improving variables
+ *  which are independent: no two of them have a common
+ *  clause or a common neighbour (a variable of a clause of
+ *  both). So the improvements add up and the clause and
+ *  score updates of the variables touch disjoint parts of
+ *  the lists, which the thread pool applies in parallel.
+ *  If there are less than 2 independent improving
+ *  variables, the algorithm does its step as usual.
+ *  The weighted mode doesn't use multi-flip steps.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include "multiflip.h"
+
+
+/* External variable for the option of the maximum number
+ * of variables of a multi-flip step (see --multiflip).
+ * 0 disables the multi-flip steps. */
+unsigned int multiflipMax = 0;
+
+/* External variable which is true, if the maximum was
+ * given by --multiflip (see featuresSelect()). */
+bool multiflipGiven = false;
+
+
+/* External variable which is true, if the flippedVariables
+ * were selected by multiflipGetFlippedVariables() and are
+ * not applied yet. */
+bool multiflipIndependent = false;
+
+
+/* External variable for the improving variables of the
+ * current step. The candidates of a chunk are stored from
+ * the first variable of the chunk on, then all candidates
+ * are moved to the front (from the index 1 on). */
+unsigned int *multiflipCandidates = NULL;
+
+
+/* External variables for the independence test. A variable
+ * is blocked in the current step, if its stamp is the
+ * multiflipGeneration. */
+unsigned int *multiflipStamp;
+unsigned int multiflipGeneration;
+
+
+/* External variable for the number of occurrences of the
+ * selected variables, which decides the number of chunks
+ * of the update. */
+unsigned int multiflipOccurrences;
+
+
+/* External variables for the lists of the chunk jobs. */
+int *multiflipScoreList;
+int *multiflipFlippedVariables;
+unsigned short *multiflipSolution;
+int **multiflipVarList;
+int *multiflipClauseStatusList;
+
+
+/* multiflipInitialisation()
+ *
+ * Allocates the lists of the multi-flip steps, if they are
+ * enabled. */
+void multiflipInitialisation(int ***varList) {
+	if (multiflipMax == 0 || clauseWeightList != NULL)
+		return;
+
+	multiflipCandidates = calloc(((*varList)[0][0] + 1), sizeof(unsigned int));
+	if (multiflipCandidates == NULL)
+		perror("calloc() for multiflipCandidates failed");
+
+	multiflipStamp = calloc(((*varList)[0][0] + 1), sizeof(unsigned int));
+	if (multiflipStamp == NULL)
+		perror("calloc() for multiflipStamp failed");
+
+	multiflipGeneration = 0;
+	multiflipIndependent = false;
+}
+
+
+/* multiflipScanChunk()
+ *
+ * Stores the improving variables first to last, which are
+ * not fixed, as candidates. */
+void multiflipScanChunk(unsigned int chunk, unsigned int first, unsigned int last) {
+	unsigned int iVarList;				/* Loop variable for the varList */
+	unsigned int numCandidates = 0;		/* Number of candidates of this chunk */
+
+
+	for (iVarList = first; iVarList <= last; iVarList++) {	/* Loop over every variable */
+		if (multiflipScoreList[iVarList] > 0 && fixedVariables[iVarList] == 0) {
+			multiflipCandidates[first + numCandidates] = iVarList;
+			numCandidates++;
+		}
+	}
+
+	parallelChunkCount[chunk] = numCandidates;
+}
+
+
+/* multiflipBlocked()
+ *
+ * Returns true, if a variable of a clause of the variable
+ * is blocked by an already selected variable. If block is
+ * true, these variables are blocked for the following
+ * candidates instead. */
+bool multiflipBlocked(unsigned int var, bool block, int ***clauseList, int ***varList) {
+	unsigned int iVarListClause;	/* Loop variable for the clauses of the variable. */
+	unsigned int iClauseListLit;	/* Loop variable for the literals of the clause. */
+	int *occurrences;				/* Clauses which contain the variable. */
+	int *clause;					/* Current clause of the loop. */
+	unsigned int curVar;			/* Variable of the current literal. */
+
+
+	occurrences = (*varList)[var];
+
+	for (iVarListClause = 1; iVarListClause <= occurrences[0]; iVarListClause++) {	/* Loop over every clause which contains this variable. */
+		clause = (*clauseList)[(occurrences[iVarListClause] > 0 ? occurrences[iVarListClause] : (occurrences[iVarListClause] * -1))];
+
+		for (iClauseListLit = 1; iClauseListLit <= clause[0]; iClauseListLit++) {
+			curVar = (clause[iClauseListLit] > 0 ? clause[iClauseListLit] : (clause[iClauseListLit] * -1));
+
+			if (block == true)
+				multiflipStamp[curVar] = multiflipGeneration;
+			else if (multiflipStamp[curVar] == multiflipGeneration)
+				return true;
+		}
+	}
+
+	if (block == true)
+		multiflipOccurrences = multiflipOccurrences + occurrences[0];
+
+	return false;
+}
+
+
+/* multiflipGetFlippedVariables()
+ *
+ * Selects up to multiflipMax independent improving
+ * variables. The selection starts at a random candidate
+ * and takes every candidate which isn't blocked by the
+ * variables before. It returns:
+ * - "0" if there are less than 2 independent improving
+ *   variables (the algorithm does the step) or
+ * - "1" the variables are in the flippedVariables. */
+short multiflipGetFlippedVariables(int **flippedVariables, int ***clauseList, int ***varList, int **varScoreList) {
+	unsigned int numVars = (*varList)[0][0];		/* Number of variables. */
+	unsigned int numChunks = parallelChunks(numVars);	/* Number of chunks of the scan. */
+	unsigned int numCandidates;						/* Number of improving variables. */
+	unsigned int iChunks;							/* Loop variable for the chunks. */
+	unsigned int iCandidates;						/* Loop variable for the candidates. */
+	unsigned int firstCandidate;					/* Random candidate where the selection starts. */
+	unsigned int var;								/* Current candidate. */
+
+
+	multiflipIndependent = false;
+
+	if (multiflipCandidates == NULL)
+		return 0;
+
+
+	/* The improving variables */
+	multiflipScoreList = *varScoreList;
+
+	if (numChunks == 1)
+		multiflipScanChunk(0, 1, numVars);
+	else
+		parallelRun(multiflipScanChunk, numVars, numChunks);
+
+	numCandidates = parallelChunkCount[0];
+
+	for (iChunks = 1; iChunks < numChunks; iChunks++) {	/* The chunks are moved in their order, so the result doesn't depend on the threads. */
+		memmove(&multiflipCandidates[numCandidates + 1], &multiflipCandidates[parallelChunkFirst(iChunks, numVars, numChunks)], parallelChunkCount[iChunks] * sizeof(unsigned int));
+		numCandidates = numCandidates + parallelChunkCount[iChunks];
+	}
+
+	if (numCandidates < 2)
+		return 0;
+
+
+	/* The independent variables */
+	multiflipGeneration++;
+
+	if (multiflipGeneration == 0) {	/* The stamps of older steps could match again. */
+		memset(multiflipStamp, 0, sizeof(unsigned int) * (numVars + 1));
+		multiflipGeneration = 1;
+	}
+
+	(*flippedVariables)[0] = 0;
+	multiflipOccurrences = 0;
+	firstCandidate = rand() % numCandidates;
+
+	for (iCandidates = 0; iCandidates < numCandidates && (*flippedVariables)[0] < multiflipMax; iCandidates++) {
+		var = multiflipCandidates[((firstCandidate + iCandidates) % numCandidates) + 1];
+
+		if (multiflipBlocked(var, false, &(*clauseList), &(*varList)) == true)
+			continue;
+
+		multiflipBlocked(var, true, &(*clauseList), &(*varList));
+
+		(*flippedVariables)[0] = (*flippedVariables)[0] + 1;
+		(*flippedVariables)[(*flippedVariables)[0]] = var;
+		TRACE_REASON((*flippedVariables)[0], TRACE_REASON_MULTIFLIP);
+	}
+
+	if ((*flippedVariables)[0] < 2) {
+		(*flippedVariables)[0] = 0;
+		return 0;
+	}
+
+	multiflipIndependent = true;
+
+	return 1;
+}
+
+
+/* multiflipUpdateChunk()
+ *
+ * Updates the clauseStatusList (and the k-SAT scores) for
+ * the flipped variables first to last and stores the
+ * change of the number of unsatisfied clauses. */
+void multiflipUpdateChunk(unsigned int chunk, unsigned int first, unsigned int last) {
+	unsigned int iFlippedVariables;		/* Loop variable for flippedVariables. */
+	unsigned int iVarListClause;		/* Loop variable for varList. */
+	int unsatisfiedClauses = 0;			/* Change of the number of unsatisfied clauses. */
+	unsigned short varValue;			/* Current variable status. */
+	int *occurrences;					/* Clauses which contain the current variable. */
+	int curClause;						/* Current selected clause in the iVarListClause loop. */
+	unsigned int clause;				/* Number of curClause. */
+	int oldClauseStatus;				/* Number of true literals before the flip. */
+
+
+	if (ksatLength != 0) {
+		parallelChunkValue[chunk] = ksatUpdateFlippedVariables(&multiflipFlippedVariables, first, last, &multiflipSolution, &multiflipVarList, &multiflipClauseStatusList);
+		return;
+	}
+
+	for (iFlippedVariables = first; iFlippedVariables <= last; iFlippedVariables++) {
+		varValue = multiflipSolution[multiflipFlippedVariables[iFlippedVariables]];
+		occurrences = multiflipVarList[multiflipFlippedVariables[iFlippedVariables]];
+
+		for (iVarListClause = 1; iVarListClause <= occurrences[0]; iVarListClause++) {	/* Loop over every clause which contains this variable. */
+			curClause = occurrences[iVarListClause];
+			clause = (curClause > 0 ? curClause : (curClause * -1));
+			oldClauseStatus = multiflipClauseStatusList[clause];
+
+			if ((curClause > 0) == (varValue == 1)) {	/* After the variable flip, the literal is true. */
+				multiflipClauseStatusList[clause] = oldClauseStatus + 1;
+				unsatisfiedClauses = unsatisfiedClauses - (oldClauseStatus == 0);
+			} else {									/* After the variable flip, the literal is false. */
+				multiflipClauseStatusList[clause] = oldClauseStatus - 1;
+				unsatisfiedClauses = unsatisfiedClauses + (oldClauseStatus == 1);
+			}
+		}
+	}
+
+	parallelChunkValue[chunk] = unsatisfiedClauses;
+}
+
+
+/* multiflipUpdateClauseStatusList()
+ *
+ * The parallel version of updateClauseStatusList() for the
+ * variables of a multi-flip step. Returns false if there
+ * are too few occurrences for the thread pool, then
+ * nothing is done. */
+bool multiflipUpdateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList) {
+	unsigned int numChunks = parallelChunks(multiflipOccurrences);	/* Number of chunks. */
+	unsigned int iChunks;											/* Loop variable for the chunks. */
+
+
+	multiflipIndependent = false;
+
+	if (numChunks > (*flippedVariables)[0])
+		numChunks = (*flippedVariables)[0];
+
+	if (numChunks <= 1)
+		return false;
+
+	multiflipFlippedVariables = *flippedVariables;
+	multiflipSolution = *solution;
+	multiflipVarList = *varList;
+	multiflipClauseStatusList = *clauseStatusList;
+
+	parallelRun(multiflipUpdateChunk, (*flippedVariables)[0], numChunks);
+
+	for (iChunks = 0; iChunks < numChunks; iChunks++)
+		(*clauseStatusList)[0] = (*clauseStatusList)[0] + parallelChunkValue[iChunks];
+
+	return true;
+}
+
+
+/* multiflipCleanUp()
+ *
+ * Deallocate memory which was used by the multi-flip
+ * steps. */
+void multiflipCleanUp() {
+	free(multiflipCandidates);
+	multiflipCandidates = NULL;
+
+	free(multiflipStamp);
+	multiflipStamp = NULL;
+
+	multiflipIndependent = false;
+}
@@ -0,0 +1,48 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * multiflip.h
+ *
+ *    This is the header file for multiflip.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef MULTIFLIP_H
+#define MULTIFLIP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+
+extern unsigned int multiflipMax;
+
+extern bool multiflipGiven;
+
+extern bool multiflipIndependent;
+
+
+void multiflipInitialisation(int ***varList);
+
+short multiflipGetFlippedVariables(int **flippedVariables, int ***clauseList, int ***varList, int **varScoreList);
+
+bool multiflipUpdateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList);
+
+void multiflipCleanUp();
+
+
+#endif /* MULTIFLIP_H */
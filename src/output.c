@@ -0,0 +1,270 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * output.c
+ *
+ * 	This file contains the output of the results:
+ *  - The "v" lines of the model are formatted into one
+ *    buffer without printf() and wrapped at
+ *    OUTPUT_LINE_LENGTH characters.
+ *  - The model file (--model-file) contains the model (it
+ *    isn't written without one) as a bitset: the magic OUTPUT_MODEL_MAGIC, the number of
+ *    variables as 8 bytes (little endian) and one bit per
+ *    variable, the variable v is the bit (v - 1) % 8 of the
+ *    byte (v - 1) / 8 (1 = true).
+ *  - The result file (--result) gets one record per run
+ *    appended with the instance, the algorithm, the seed,
+ *    the status, the number of unsatisfied clauses, the
+ *    cost (weighted mode), the flips, the restarts and the
+ *    seconds: a CSV row (with a header line for a new file),
+ *    if the path ends with ".csv", otherwise a JSON object
+ *    in one line.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include "output.h"
+
+
+/* External variables for the options of the model file
+ * and the result file. */
+char outputModelFilePath[OUTPUT_FILE_PATH_MAXLENGTH + 1] = "";
+char outputResultFilePath[OUTPUT_FILE_PATH_MAXLENGTH + 1] = "";
+
+
+/* External variable for the output buffer. */
+char outputBuffer[OUTPUT_BUFFER_SIZE];
+
+
+/* External variables for the run of the result record
+ * (see outputStart()). */
+char *outputInstanceFilePath = "";
+char *outputAlgoName = "";
+unsigned int outputRandomSeed = 0;
+struct timespec outputStartTime;
+
+
+/* outputStart()
+ *
+ * Notes the begin and the parameters of the run for the
+ * result record and removes the model file of an earlier
+ * run, so it only exists if this run finds a model. The algorithm name is read at the end, so
+ * it is the selected one for "auto". */
+void outputStart(char instanceFilePath[], char algoName[], unsigned int randomSeed) {
+	outputInstanceFilePath = instanceFilePath;
+	outputAlgoName = algoName;
+	outputRandomSeed = randomSeed;
+
+	clock_gettime(CLOCK_MONOTONIC, &outputStartTime);
+
+	if (strlen(outputModelFilePath) > 0 && unlink(outputModelFilePath) != 0 && errno != ENOENT)
+		perror("unlink() for the model file failed");
+}
+
+
+/* outputModel()
+ *
+ * Prints the "v" lines of the solution. */
+void outputModel(unsigned short *solution, unsigned int numVars) {
+	char digits[12];				/* The digits of a variable in the reverse order. */
+	unsigned int numDigits;			/* Number of digits. */
+	unsigned int length = 0;		/* Used bytes of the buffer. */
+	unsigned int lineLength;		/* Length of the current line. */
+	unsigned int iSolution;			/* Loop variable for the solution. */
+	unsigned int value;				/* The remaining digits. */
+
+
+	memcpy(outputBuffer, "v", 1);
+	length = 1;
+	lineLength = 1;
+
+	for (iSolution = 1; iSolution <= numVars + 1; iSolution++) {	/* The last literal is the "0". */
+		numDigits = 0;
+		value = (iSolution <= numVars ? iSolution : 0);
+
+		do {
+			digits[numDigits++] = '0' + value % 10;
+			value = value / 10;
+		} while (value > 0);
+
+		if (iSolution <= numVars && solution[iSolution] == 0)
+			digits[numDigits++] = '-';
+
+		if (lineLength + 1 + numDigits > OUTPUT_LINE_LENGTH) {	/* The literal starts a new line. */
+			memcpy(&outputBuffer[length], "\nv", 2);
+			length = length + 2;
+			lineLength = 1;
+		}
+
+		outputBuffer[length++] = ' ';
+		lineLength = lineLength + 1 + numDigits;
+
+		while (numDigits > 0)
+			outputBuffer[length++] = digits[--numDigits];
+
+		if (length > OUTPUT_BUFFER_SIZE - 2 * sizeof(digits)) {	/* Space for the next literal and its line break. */
+			fwrite(outputBuffer, 1, length, stdout);
+			length = 0;
+		}
+	}
+
+	outputBuffer[length++] = '\n';
+	fwrite(outputBuffer, 1, length, stdout);
+}
+
+
+/* outputModelFile()
+ *
+ * Writes the solution as a bitset into the model file, if
+ * there is one (see above). Only models are written: a
+ * satisfying solution or the solution of a weighted
+ * instance which satisfies all hard clauses, never the
+ * best candidate of an unknown result. */
+void outputModelFile(unsigned short *solution, unsigned int numVars) {
+	FILE *modelFileHandle;			/* File handle for the model file. */
+	unsigned int length = 0;		/* Used bytes of the buffer. */
+	unsigned int iSolution;			/* Loop variable for the solution. */
+	unsigned int iBytes;			/* Loop variable for the bytes of the number of variables. */
+
+
+	if (strlen(outputModelFilePath) == 0)
+		return;
+
+	modelFileHandle = fopen(outputModelFilePath, "wb");
+	if (modelFileHandle == NULL) {
+		perror("fopen() for the model file failed");
+		return;
+	}
+
+	memcpy(outputBuffer, OUTPUT_MODEL_MAGIC, strlen(OUTPUT_MODEL_MAGIC));
+	length = strlen(OUTPUT_MODEL_MAGIC);
+
+	for (iBytes = 0; iBytes < 8; iBytes++)
+		outputBuffer[length++] = ((unsigned long long)numVars >> (8 * iBytes)) & 0xff;
+
+	outputBuffer[length] = 0;
+
+	for (iSolution = 1; iSolution <= numVars; iSolution++) {
+		outputBuffer[length] |= (solution[iSolution] == 1) << ((iSolution - 1) % 8);
+
+		if (iSolution % 8 == 0 || iSolution == numVars) {	/* The byte is complete. */
+			length++;
+
+			if (length == OUTPUT_BUFFER_SIZE) {
+				fwrite(outputBuffer, 1, length, modelFileHandle);
+				length = 0;
+			}
+
+			outputBuffer[length] = 0;
+		}
+	}
+
+	fwrite(outputBuffer, 1, length, modelFileHandle);
+
+	if (fclose(modelFileHandle) != 0)
+		perror("fclose() for the model file failed");
+}
+
+
+/* outputString()
+ *
+ * Writes a string into the result file, quoted for CSV or
+ * JSON. */
+void outputString(char string[], bool csv, FILE *resultFileHandle) {
+	unsigned int iString;	/* Loop variable for the string. */
+
+
+	fputc('"', resultFileHandle);
+
+	for (iString = 0; string[iString] != '\0'; iString++) {
+		if (csv == true && string[iString] == '"')
+			fputs("\"\"", resultFileHandle);
+		else if (csv == false && (string[iString] == '"' || string[iString] == '\\'))
+			fprintf(resultFileHandle, "\\%c", string[iString]);
+		else if (csv == false && (unsigned char)string[iString] < 0x20)
+			fprintf(resultFileHandle, "\\u%04x", string[iString]);
+		else
+			fputc(string[iString], resultFileHandle);
+	}
+
+	fputc('"', resultFileHandle);
+}
+
+
+/* outputResult()
+ *
+ * Appends the result record of the run to the result file,
+ * if there is one (see above). A negative number of
+ * unsatisfied clauses or cost is unknown. */
+void outputResult(char status[], long long unsatisfiedClauses, long long cost) {
+	FILE *resultFileHandle;		/* File handle for the result file. */
+	struct timespec end;		/* End of the run. */
+	double seconds;				/* Seconds of the run. */
+	bool csv;					/* Is the result file a CSV file? */
+
+
+	if (strlen(outputResultFilePath) == 0)
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (end.tv_sec - outputStartTime.tv_sec) + (end.tv_nsec - outputStartTime.tv_nsec) / 1e9;
+
+	csv = (strlen(outputResultFilePath) >= 4 && strcmp(&outputResultFilePath[strlen(outputResultFilePath) - 4], ".csv") == 0);
+
+	resultFileHandle = fopen(outputResultFilePath, "a");
+	if (resultFileHandle == NULL) {
+		perror("fopen() for the result file failed");
+		return;
+	}
+
+	if (csv == true) {
+		if (ftell(resultFileHandle) == 0)	/* A new file */
+			fprintf(resultFileHandle, "instance,algorithm,seed,status,unsatisfied,cost,flips,restarts,seconds\n");
+
+		outputString(outputInstanceFilePath, true, resultFileHandle);
+		fprintf(resultFileHandle, ",%s,%u,%s,", outputAlgoName, outputRandomSeed, status);
+
+		if (unsatisfiedClauses >= 0)
+			fprintf(resultFileHandle, "%lld", unsatisfiedClauses);
+
+		fprintf(resultFileHandle, ",");
+
+		if (cost >= 0)
+			fprintf(resultFileHandle, "%lld", cost);
+
+		fprintf(resultFileHandle, ",%llu,%u,%.6f\n", solverFlips, solverRestarts, seconds);
+	} else {
+		fprintf(resultFileHandle, "{\"instance\":");
+		outputString(outputInstanceFilePath, false, resultFileHandle);
+		fprintf(resultFileHandle, ",\"algorithm\":");
+		outputString(outputAlgoName, false, resultFileHandle);
+		fprintf(resultFileHandle, ",\"seed\":%u,\"status\":\"%s\",\"unsatisfied\":", outputRandomSeed, status);
+
+		if (unsatisfiedClauses >= 0)
+			fprintf(resultFileHandle, "%lld", unsatisfiedClauses);
+		else
+			fprintf(resultFileHandle, "null");
+
+		fprintf(resultFileHandle, ",\"cost\":");
+
+		if (cost >= 0)
+			fprintf(resultFileHandle, "%lld", cost);
+		else
+			fprintf(resultFileHandle, "null");
+
+		fprintf(resultFileHandle, ",\"flips\":%llu,\"restarts\":%u,\"seconds\":%.6f}\n", solverFlips, solverRestarts, seconds);
+	}
+
+	if (fclose(resultFileHandle) != 0)
+		perror("fclose() for the result file failed");
+}
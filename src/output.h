@@ -0,0 +1,55 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * output.h
+ *
+ *    This is the header file for output.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "solver.h"
+
+
+#define OUTPUT_FILE_PATH_MAXLENGTH 255		/* The maximum length of the model and the result file paths. */
+#define OUTPUT_BUFFER_SIZE 65536			/* The size of the output buffer in bytes. */
+#define OUTPUT_LINE_LENGTH 80				/* The maximum length of a "v" line. */
+#define OUTPUT_MODEL_MAGIC "PSATMDL1"		/* The first bytes of a model file. */
+
+
+extern char outputModelFilePath[OUTPUT_FILE_PATH_MAXLENGTH + 1];
+
+extern char outputResultFilePath[OUTPUT_FILE_PATH_MAXLENGTH + 1];
+
+
+void outputStart(char instanceFilePath[], char algoName[], unsigned int randomSeed);
+
+void outputModel(unsigned short *solution, unsigned int numVars);
+
+void outputModelFile(unsigned short *solution, unsigned int numVars);
+
+void outputResult(char status[], long long unsatisfiedClauses, long long cost);
+
+
+#endif /* OUTPUT_H */
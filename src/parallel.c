@@ -0,0 +1,356 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * parallel.c
+ *
+ * 	This file contains the thread pool for the data parallel
+ *  parts of a single search. The pool is started once and
+ *  its threads sleep until the search thread runs a job.
+ *  A job is split into chunks of consecutive variables or
+ *  clauses, which the threads (including the search
+ *  thread) take from a shared counter, so a thread which
+ *  is done early takes over the remaining chunks of the
+ *  slower ones. The results of a chunk are stored by its
+ *  number, so the reductions are done in the order of the
+ *  chunks and the search is the same for every number of
+ *  threads. All threads work on the one formula.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include "parallel.h"
+
+
+/* External variable for the option of the number of
+ * threads of a search (see --threads). */
+unsigned int parallelThreads = 1;
+
+
+/* External variables for the results of the chunks of
+ * the last job. Their meaning depends on the job. */
+long long parallelChunkValue[PARALLEL_CHUNKS_MAX];
+unsigned int parallelChunkCount[PARALLEL_CHUNKS_MAX];
+unsigned int parallelChunkVariable[PARALLEL_CHUNKS_MAX];
+
+
+/* External variables for the thread pool. A new job
+ * increases parallelGeneration and wakes the threads.
+ * parallelActiveWorkers is the number of threads in
+ * parallelWork(), a new job waits until it is 0, so no
+ * thread takes a chunk of the last job. */
+pthread_t parallelWorkers[PARALLEL_THREADS_MAX];
+unsigned int parallelNumWorkers = 0;
+unsigned int parallelActiveWorkers = 0;
+pthread_mutex_t parallelMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t parallelWorkCondition = PTHREAD_COND_INITIALIZER;
+pthread_cond_t parallelDoneCondition = PTHREAD_COND_INITIALIZER;
+unsigned long long parallelGeneration = 0;
+bool parallelShutdown = false;
+
+
+/* External variables for the current job. */
+void (*parallelJob)(unsigned int chunk, unsigned int first, unsigned int last);
+unsigned int parallelNumItems;
+unsigned int parallelNumChunks;
+atomic_uint parallelNextChunk = 0;
+atomic_uint parallelDoneChunks = 0;
+
+
+/* External variables for the lists of the rebuild jobs. */
+unsigned short *parallelSolution;
+int **parallelClauseList;
+int **parallelVarList;
+int *parallelVarScoreList;
+int *parallelClauseStatusList;
+
+
+/* parallelChunks()
+ *
+ * Returns the number of chunks for a job over numItems
+ * variables or clauses. 1 means that the job is not
+ * worth the synchronisation and runs in the search
+ * thread only. */
+unsigned int parallelChunks(unsigned int numItems) {
+	unsigned int numChunks = numItems / PARALLEL_CHUNK_MIN;	/* Number of chunks with the minimum size. */
+
+
+	if (parallelNumWorkers == 0 || numChunks < 2)
+		return 1;
+
+	if (numChunks > (parallelNumWorkers + 1) * PARALLEL_CHUNKS_PER_THREAD)
+		numChunks = (parallelNumWorkers + 1) * PARALLEL_CHUNKS_PER_THREAD;
+
+	return numChunks;
+}
+
+
+/* parallelChunkFirst()
+ *
+ * Returns the first item (counted from 1) of the chunk.
+ * The chunk ends before the first item of the next
+ * chunk. */
+unsigned int parallelChunkFirst(unsigned int chunk, unsigned int numItems, unsigned int numChunks) {
+	return (unsigned int)(((unsigned long long)numItems * chunk) / numChunks) + 1;
+}
+
+
+/* parallelWork()
+ *
+ * Runs chunks of the current job until there are no
+ * chunks left. */
+void parallelWork() {
+	unsigned int chunk;		/* The current chunk. */
+
+
+	while ((chunk = atomic_fetch_add(&parallelNextChunk, 1)) < parallelNumChunks) {
+		parallelJob(chunk, parallelChunkFirst(chunk, parallelNumItems, parallelNumChunks), parallelChunkFirst(chunk + 1, parallelNumItems, parallelNumChunks) - 1);
+
+		if (atomic_fetch_add(&parallelDoneChunks, 1) + 1 == parallelNumChunks) {	/* The last chunk of the job */
+			pthread_mutex_lock(&parallelMutex);
+			pthread_cond_signal(&parallelDoneCondition);
+			pthread_mutex_unlock(&parallelMutex);
+		}
+	}
+}
+
+
+/* parallelWorkerThread()
+ *
+ * Waits for a new job and takes part in it until the
+ * pool is shut down. */
+void *parallelWorkerThread(void *argument) {
+	unsigned long long generation = 0;	/* The generation of the last job of this thread. */
+
+
+	pthread_mutex_lock(&parallelMutex);
+
+	while (true) {
+		while (parallelGeneration == generation && parallelShutdown == false)
+			pthread_cond_wait(&parallelWorkCondition, &parallelMutex);
+
+		if (parallelShutdown == true)
+			break;
+
+		generation = parallelGeneration;
+		parallelActiveWorkers++;
+
+		pthread_mutex_unlock(&parallelMutex);
+		parallelWork();
+		pthread_mutex_lock(&parallelMutex);
+
+		parallelActiveWorkers--;
+		if (parallelActiveWorkers == 0)
+			pthread_cond_signal(&parallelDoneCondition);
+	}
+
+	pthread_mutex_unlock(&parallelMutex);
+
+	return NULL;
+}
+
+
+/* parallelInitialisation()
+ *
+ * Starts the threads of the pool. The search thread is
+ * one of the parallelThreads. */
+void parallelInitialisation() {
+	while (parallelNumWorkers + 1 < parallelThreads) {
+		if (pthread_create(&parallelWorkers[parallelNumWorkers], NULL, parallelWorkerThread, NULL) != 0) {
+			perror("pthread_create() for the thread pool failed");
+			break;
+		}
+
+		parallelNumWorkers++;
+	}
+
+	atexit(parallelCleanUp);
+}
+
+
+/* parallelRun()
+ *
+ * Runs the job for the chunks of numItems items and
+ * returns after all chunks are done. */
+void parallelRun(void (*job)(unsigned int chunk, unsigned int first, unsigned int last), unsigned int numItems, unsigned int numChunks) {
+	pthread_mutex_lock(&parallelMutex);
+
+	while (parallelActiveWorkers > 0)
+		pthread_cond_wait(&parallelDoneCondition, &parallelMutex);
+
+	parallelJob = job;
+	parallelNumItems = numItems;
+	parallelNumChunks = numChunks;
+	atomic_store(&parallelDoneChunks, 0);
+	atomic_store(&parallelNextChunk, 0);
+
+	parallelGeneration++;
+	pthread_cond_broadcast(&parallelWorkCondition);
+
+	pthread_mutex_unlock(&parallelMutex);
+
+
+	parallelWork();
+
+
+	pthread_mutex_lock(&parallelMutex);
+
+	while (atomic_load(&parallelDoneChunks) < numChunks)
+		pthread_cond_wait(&parallelDoneCondition, &parallelMutex);
+
+	pthread_mutex_unlock(&parallelMutex);
+}
+
+
+/* parallelClauseStatusJob()
+ *
+ * Determines the clauseStatusList of the clauses first to
+ * last and their number of unsatisfied clauses. */
+void parallelClauseStatusJob(unsigned int chunk, unsigned int first, unsigned int last) {
+	unsigned int iClauseList;		/* Loop variable for clauseList. */
+	unsigned int iClauseListLit;	/* Loop variable for every literal in the clause. */
+	unsigned int unsatisfiedClauses = 0;	/* Number of unsatisfied clauses. */
+	int *clause;					/* Current clause of the loop. */
+	unsigned int *lits;				/* Literals of the current clause (k-SAT). */
+	int trueLiterals;				/* Number of true literals in the current clause. */
+	int curLiteral;					/* Current literal of the loop. */
+
+
+	for (iClauseList = first; iClauseList <= last; iClauseList++) {
+		trueLiterals = 0;
+
+		if (ksatLength != 0) {	/* The literals with a fixed stride */
+			lits = &ksatLiterals[(iClauseList - 1) * ksatLength];
+
+			for (iClauseListLit = 0; iClauseListLit < ksatLength; iClauseListLit++)
+				trueLiterals = trueLiterals + (parallelSolution[lits[iClauseListLit] >> 1] ^ (lits[iClauseListLit] & 1));
+		} else {
+			clause = parallelClauseList[iClauseList];
+
+			for (iClauseListLit = 1; iClauseListLit <= clause[0]; iClauseListLit++) {
+				curLiteral = clause[iClauseListLit];
+				trueLiterals = trueLiterals + (curLiteral > 0 ? parallelSolution[curLiteral] : (1 - parallelSolution[(curLiteral * -1)]));
+			}
+		}
+
+		parallelClauseStatusList[iClauseList] = trueLiterals;
+		unsatisfiedClauses = unsatisfiedClauses + (trueLiterals == 0);
+	}
+
+	parallelChunkValue[chunk] = unsatisfiedClauses;
+}
+
+
+/* parallelRebuildClauseStatusList()
+ *
+ * The parallel version of rebuildClauseStatusList().
+ * Returns false if the formula is too small for the
+ * thread pool, then nothing is done. */
+bool parallelRebuildClauseStatusList(unsigned short **solution, int ***clauseList, int **clauseStatusList) {
+	unsigned int numChunks = parallelChunks((*clauseList)[0][0]);	/* Number of chunks. */
+	unsigned int iChunks;											/* Loop variable for the chunks. */
+
+
+	if (numChunks == 1)
+		return false;
+
+	parallelSolution = *solution;
+	parallelClauseList = *clauseList;
+	parallelClauseStatusList = *clauseStatusList;
+
+	parallelRun(parallelClauseStatusJob, (*clauseList)[0][0], numChunks);
+
+	(*clauseStatusList)[0] = 0;
+
+	for (iChunks = 0; iChunks < numChunks; iChunks++)
+		(*clauseStatusList)[0] = (*clauseStatusList)[0] + parallelChunkValue[iChunks];
+
+	return true;
+}
+
+
+/* parallelVarScoreJob()
+ *
+ * Determines the scores of the variables first to last:
+ * +1 for each unsatisfied clause and -1 for each clause
+ * which is only satisfied by this variable. */
+void parallelVarScoreJob(unsigned int chunk, unsigned int first, unsigned int last) {
+	unsigned int iVarList;			/* Loop variable for varList. */
+	unsigned int iVarListClause;	/* Loop variable for clauses in the varList. */
+	int *occurrences;				/* Clauses which contain the current variable. */
+	int curClause;					/* Current selected clause in the iVarListClause loop. */
+	int clauseStatus;				/* Number of true literals of the current clause. */
+	int score;						/* Score of the current variable. */
+
+
+	for (iVarList = first; iVarList <= last; iVarList++) {
+		occurrences = parallelVarList[iVarList];
+		score = 0;
+
+		for (iVarListClause = 1; iVarListClause <= occurrences[0]; iVarListClause++) {
+			curClause = occurrences[iVarListClause];
+			clauseStatus = parallelClauseStatusList[(curClause > 0 ? curClause : (curClause * -1))];
+
+			if (clauseStatus == 0)		/* An flip will satisfied this clause. */
+				score++;
+			else if (clauseStatus == 1 && parallelSolution[iVarList] == (curClause > 0 ? 1 : 0))	/* An flip will unsatisfied this clause. */
+				score--;
+		}
+
+		parallelVarScoreList[iVarList] = score;
+	}
+}
+
+
+/* parallelRebuildVarScoreList()
+ *
+ * The parallel version of updateVarScoreList() (and of
+ * the k-SAT score rebuild). Returns false if the formula
+ * is too small for the thread pool, then nothing is
+ * done. */
+bool parallelRebuildVarScoreList(unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList) {
+	unsigned int numChunks = parallelChunks((*varList)[0][0]);	/* Number of chunks. */
+
+
+	if (numChunks == 1)
+		return false;
+
+	parallelSolution = *solution;
+	parallelVarList = *varList;
+	parallelVarScoreList = *varScoreList;
+	parallelClauseStatusList = *clauseStatusList;
+
+	(*varScoreList)[0] = 0;
+
+	parallelRun(parallelVarScoreJob, (*varList)[0][0], numChunks);
+
+	return true;
+}
+
+
+/* parallelCleanUp()
+ *
+ * Stops the threads of the pool. */
+void parallelCleanUp() {
+	unsigned int iWorkers;	/* Loop variable for the threads. */
+
+
+	pthread_mutex_lock(&parallelMutex);
+	parallelShutdown = true;
+	pthread_cond_broadcast(&parallelWorkCondition);
+	pthread_mutex_unlock(&parallelMutex);
+
+	for (iWorkers = 0; iWorkers < parallelNumWorkers; iWorkers++)
+		pthread_join(parallelWorkers[iWorkers], NULL);
+
+	parallelNumWorkers = 0;
+}
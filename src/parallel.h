@@ -0,0 +1,64 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * parallel.h
+ *
+ *    This is the header file for parallel.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "solver.h"
+
+
+#define PARALLEL_THREADS_MAX 64			/* The maximum number of threads of a search. */
+#define PARALLEL_CHUNKS_PER_THREAD 4	/* Chunks per thread, so faster threads take over the work of slower ones. */
+#define PARALLEL_CHUNKS_MAX (PARALLEL_THREADS_MAX * PARALLEL_CHUNKS_PER_THREAD)
+#define PARALLEL_CHUNK_MIN 32768		/* The minimum number of variables or clauses of a chunk. */
+
+
+extern unsigned int parallelThreads;
+
+extern long long parallelChunkValue[PARALLEL_CHUNKS_MAX];
+
+extern unsigned int parallelChunkCount[PARALLEL_CHUNKS_MAX];
+
+extern unsigned int parallelChunkVariable[PARALLEL_CHUNKS_MAX];
+
+
+void parallelInitialisation();
+
+unsigned int parallelChunks(unsigned int numItems);
+
+unsigned int parallelChunkFirst(unsigned int chunk, unsigned int numItems, unsigned int numChunks);
+
+void parallelRun(void (*job)(unsigned int chunk, unsigned int first, unsigned int last), unsigned int numItems, unsigned int numChunks);
+
+bool parallelRebuildClauseStatusList(unsigned short **solution, int ***clauseList, int **clauseStatusList);
+
+bool parallelRebuildVarScoreList(unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList);
+
+void parallelCleanUp();
+
+
+#endif /* PARALLEL_H */
@@ -0,0 +1,722 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * portfolio.c
+ *
+ * 	This file contains the multi-process portfolio. Every
+ *  process searches the same formula with its own seed
+ *  (the random seed + the number of the process) and its
+ *  own configuration: the process 0 uses the given
+ *  algorithm and restart policy, the others the
+ *  configurations of portfolioAlgoNames and
+ *  portfolioPolicyNames in turn. The first process which
+ *  finds a model cancels the others, they stop within
+ *  PORTFOLIO_POLL steps. The statistics of all processes
+ *  are printed in "c Portfolio" lines.
+ *
+ *  The formula is loaded once and copied into one read-only
+ *  image (see portfolioImageWrite()), which all processes
+ *  of a host map. Only the lists which change during the
+ *  search are allocated by each process.
+ *
+ *  There are two transports:
+ *  - POSIX shared memory (--portfolio N): the processes
+ *    are forked on one host. The image, the cancellation
+ *    flag, the statistics and the model are shared
+ *    mappings. A crashed process doesn't stop the others.
+ *  - MPI (make mpi, mpirun -np N psat_mpi ...): the rank 0
+ *    loads the formula and broadcasts the image to one
+ *    rank per host, which stores it in a shared window of
+ *    all ranks of the host. The cancellation is a message
+ *    to all ranks, the statistics are gathered by the
+ *    rank 0, which also prints the model.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include "portfolio.h"
+
+
+/* External variable for the option of the number of
+ * processes of the shared memory portfolio (see
+ * --portfolio) or the number of MPI ranks. */
+unsigned int portfolioProcesses = 1;
+
+
+/* External variable which is true in a searching process
+ * of the portfolio. */
+bool portfolioActive = false;
+
+
+/* External variable which is true, if another process
+ * found a model. */
+bool portfolioCancelled = false;
+
+
+/* The configurations of the processes 1, 2, ... */
+#define PORTFOLIO_CONFIGURATIONS 6
+char *portfolioAlgoNames[PORTFOLIO_CONFIGURATIONS] = { "arots", "ilssa", "rots", "arots", "ilssa", "rots" };
+char *portfolioPolicyNames[PORTFOLIO_CONFIGURATIONS] = { "luby", "fixed", "luby", "stagnation", "geometric", "geometric" };
+
+
+/* External variables for the formula of this process. The
+ * rows of the clauseList and the varList point into the
+ * image. */
+int **portfolioClauseList;
+int **portfolioVarList;
+int *portfolioVarScoreList;
+unsigned short *portfolioSolution;
+int *portfolioClauseStatusList;
+int *portfolioFlippedVariables;
+
+
+/* External variable for the steps of this process. */
+unsigned long long portfolioSteps;
+
+
+/* External variables for the shared memory transport:
+ * the cancellation flag and the number of the process
+ * which found the model (-1 = none), the statistics
+ * (PORTFOLIO_STATISTICS for each process) and the
+ * model. */
+atomic_int *portfolioControl = NULL;
+unsigned long long *portfolioStatistics;
+unsigned short *portfolioModel;
+
+
+#ifdef PORTFOLIO_MPI
+/* External variables for the MPI transport. */
+int portfolioRank = 0;
+int portfolioCancelSent = 0;
+MPI_Request portfolioCancelRequests[PORTFOLIO_PROCESSES_MAX];
+
+
+/* portfolioMpiCleanUp()
+ *
+ * Finalises MPI at the exit of the program. */
+void portfolioMpiCleanUp() {
+	MPI_Finalize();
+}
+#endif
+
+
+/* portfolioInitialisation()
+ *
+ * Initialises MPI in the MPI build, the number of ranks is
+ * the number of processes of the portfolio. Nothing is
+ * done in the shared memory build. */
+void portfolioInitialisation(int *argc, char ***argv) {
+#ifdef PORTFOLIO_MPI
+	int size;	/* Number of ranks. */
+
+
+	MPI_Init(argc, argv);
+
+	MPI_Comm_rank(MPI_COMM_WORLD, &portfolioRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	if (size > PORTFOLIO_PROCESSES_MAX) {
+		if (portfolioRank == 0)
+			printf("The portfolio can have at most %d processes!\n", PORTFOLIO_PROCESSES_MAX);
+
+		MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+	}
+
+	portfolioProcesses = size;
+
+	atexit(portfolioMpiCleanUp);
+#endif
+}
+
+
+/* portfolioPoll()
+ *
+ * Counts the step and checks every PORTFOLIO_POLL steps,
+ * if another process found a model (see
+ * PORTFOLIO_CANCELLED()). */
+bool portfolioPoll() {
+#ifdef PORTFOLIO_MPI
+	int pending;	/* Is there a cancellation message? */
+#endif
+
+
+	if (portfolioCancelled == true)
+		return true;
+
+	portfolioSteps++;
+
+	if (portfolioSteps % PORTFOLIO_POLL != 0)
+		return false;
+
+#ifdef PORTFOLIO_MPI
+	MPI_Iprobe(MPI_ANY_SOURCE, PORTFOLIO_TAG_CANCEL, MPI_COMM_WORLD, &pending, MPI_STATUS_IGNORE);
+	portfolioCancelled = (pending != 0);
+#else
+	portfolioCancelled = (atomic_load_explicit(&portfolioControl[0], memory_order_relaxed) != 0);
+#endif
+
+	return portfolioCancelled;
+}
+
+
+/* portfolioAlgoName()
+ *
+ * Returns the algorithm name of the process. */
+char *portfolioAlgoName(unsigned int process, char algoName[]) {
+	return (process == 0 ? algoName : portfolioAlgoNames[(process - 1) % PORTFOLIO_CONFIGURATIONS]);
+}
+
+
+/* portfolioPolicyName()
+ *
+ * Returns the restart policy of the process. */
+char *portfolioPolicyName(unsigned int process) {
+	return (process == 0 ? restartPolicyName : portfolioPolicyNames[(process - 1) % PORTFOLIO_CONFIGURATIONS]);
+}
+
+
+/* portfolioImageSize()
+ *
+ * Returns the number of integers of the image of the
+ * formula. */
+size_t portfolioImageSize(int ***clauseList, int ***varList) {
+	size_t imageSize = 2;	/* The rows with the index 0 */
+	unsigned int iClauseList;	/* Loop variable for the clauseList. */
+	unsigned int iVarList;		/* Loop variable for the varList. */
+
+
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++)
+		imageSize = imageSize + (*clauseList)[iClauseList][0] + 1;
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++)
+		imageSize = imageSize + (*varList)[iVarList][0] + 1;
+
+	return imageSize;
+}
+
+
+/* portfolioImageWrite()
+ *
+ * Copies the formula into the image: the number of
+ * clauses, the rows of the clauseList, the number of
+ * variables and the rows of the varList, each row with
+ * its length at the index 0 like in the lists. */
+void portfolioImageWrite(int *image, int ***clauseList, int ***varList) {
+	unsigned int iClauseList;	/* Loop variable for the clauseList. */
+	unsigned int iVarList;		/* Loop variable for the varList. */
+
+
+	*image = (*clauseList)[0][0];
+	image++;
+
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++) {
+		memcpy(image, (*clauseList)[iClauseList], sizeof(int) * ((*clauseList)[iClauseList][0] + 1));
+		image = image + (*clauseList)[iClauseList][0] + 1;
+	}
+
+	*image = (*varList)[0][0];
+	image++;
+
+	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {
+		memcpy(image, (*varList)[iVarList], sizeof(int) * ((*varList)[iVarList][0] + 1));
+		image = image + (*varList)[iVarList][0] + 1;
+	}
+}
+
+
+/* portfolioAttach()
+ *
+ * Points the rows of the formula of this process into the
+ * image and allocates the lists which change during the
+ * search. */
+void portfolioAttach(int *image) {
+	unsigned int numClauses;	/* Number of clauses. */
+	unsigned int numVars;		/* Number of variables. */
+	unsigned int iClauseList;	/* Loop variable for the clauseList. */
+	unsigned int iVarList;		/* Loop variable for the varList. */
+
+
+	numClauses = *image;
+
+	portfolioClauseList = malloc(sizeof(int *) * (numClauses + 1));
+	if (portfolioClauseList == NULL)
+		perror("malloc() for the portfolio clauseList failed");
+
+	portfolioClauseList[0] = image;
+	image++;
+
+	for (iClauseList = 1; iClauseList <= numClauses; iClauseList++) {
+		portfolioClauseList[iClauseList] = image;
+		image = image + *image + 1;
+	}
+
+	numVars = *image;
+
+	portfolioVarList = malloc(sizeof(int *) * (numVars + 1));
+	if (portfolioVarList == NULL)
+		perror("malloc() for the portfolio varList failed");
+
+	portfolioVarList[0] = image;
+	image++;
+
+	for (iVarList = 1; iVarList <= numVars; iVarList++) {
+		portfolioVarList[iVarList] = image;
+		image = image + *image + 1;
+	}
+
+	portfolioVarScoreList = calloc((numVars + 1), sizeof(int));
+	portfolioSolution = calloc((numVars + 1), sizeof(unsigned short));
+	portfolioClauseStatusList = calloc((numClauses + 1), sizeof(int));
+	portfolioFlippedVariables = calloc((numVars + 1), sizeof(int));
+	if (portfolioVarScoreList == NULL || portfolioSolution == NULL || portfolioClauseStatusList == NULL || portfolioFlippedVariables == NULL)
+		perror("calloc() for the portfolio lists failed");
+
+	portfolioSolution[0] = numVars;
+	solverNumVars = numVars;
+
+	free(fixedVariables);
+	fixedVariables = calloc((numVars + 1), sizeof(unsigned short));
+	if (fixedVariables == NULL)
+		perror("calloc() for fixedVariables failed");
+}
+
+
+/* portfolioDetach()
+ *
+ * Deallocate the lists of the formula of this process,
+ * the image is kept. */
+void portfolioDetach() {
+	free(portfolioClauseList);
+	free(portfolioVarList);
+	free(portfolioVarScoreList);
+	free(portfolioSolution);
+	free(portfolioClauseStatusList);
+	free(portfolioFlippedVariables);
+
+	free(fixedVariables);
+	fixedVariables = NULL;
+}
+
+
+/* portfolioSearch()
+ *
+ * Searches the formula of the image with the seed and the
+ * configuration of the process and stores its statistics.
+ * The function returns the number of the unsatisfied
+ * clauses, the solution candidate is portfolioSolution. */
+int portfolioSearch(unsigned int process, int *image, char algoName[], unsigned int maxRestarts, unsigned int randomSeed, unsigned long long statistics[]) {
+	char processAlgoName[PSAT_ALGONAME_MAXLENGTH + 1];	/* The algorithm of this process. */
+	struct timespec start;			/* Begin of the search. */
+	struct timespec end;			/* End of the search. */
+	int solutionQuality;			/* Return value */
+
+
+	strcpy(processAlgoName, portfolioAlgoName(process, algoName));
+	if (process > 0)	/* The process 0 keeps the given restart policy. */
+		strcpy(restartPolicyName, portfolioPolicyName(process));
+
+	checkpointSeed(randomSeed + process);
+
+	signal(SIGTERM, SIG_DFL);	/* The portfolio is cancelled as a whole. */
+	setvbuf(stdout, NULL, _IOLBF, 0);	/* The "c" lines of the processes are not mixed. */
+
+	if (parallelThreads > 1)
+		parallelInitialisation();
+
+	portfolioAttach(image);
+
+	portfolioActive = true;
+	portfolioSteps = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	solutionQuality = solverSearch(&portfolioSolution, &portfolioClauseList, &portfolioVarList, &portfolioVarScoreList, &portfolioClauseStatusList, &portfolioFlippedVariables, processAlgoName, maxRestarts, false);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	portfolioActive = false;
+
+	statistics[PORTFOLIO_STATISTIC_STATUS] = 1;
+	statistics[PORTFOLIO_STATISTIC_QUALITY] = solutionQuality;
+	statistics[PORTFOLIO_STATISTIC_RESTARTS] = solverRestarts;
+	statistics[PORTFOLIO_STATISTIC_STEPS] = portfolioSteps;
+	statistics[PORTFOLIO_STATISTIC_MICROSECONDS] = (end.tv_sec - start.tv_sec) * 1000000ULL + (end.tv_nsec - start.tv_nsec) / 1000;
+	statistics[PORTFOLIO_STATISTIC_FLIPS] = solverFlips;
+
+	return solutionQuality;
+}
+
+
+/* portfolioPrintStatistics()
+ *
+ * Prints the statistics of all processes and the sums.
+ * The sums of the flips and the restarts are also stored
+ * in solverFlips and solverRestarts. */
+void portfolioPrintStatistics(unsigned long long statistics[], int winner, char algoName[], unsigned int randomSeed) {
+	unsigned int iProcesses;			/* Loop variable for the processes. */
+	unsigned long long steps = 0;		/* Steps of all processes. */
+	unsigned long long *processStatistics;	/* Statistics of the current process. */
+
+
+	solverFlips = 0;
+	solverRestarts = 0;
+
+	for (iProcesses = 0; iProcesses < portfolioProcesses; iProcesses++) {
+		processStatistics = &statistics[iProcesses * PORTFOLIO_STATISTICS];
+
+		printf("c Portfolio process %u (%s, restart policy %s, seed %u): ", iProcesses, portfolioAlgoName(iProcesses, algoName), portfolioPolicyName(iProcesses), randomSeed + iProcesses);
+
+		if (processStatistics[PORTFOLIO_STATISTIC_STATUS] == 0) {
+			printf("crashed\n");
+			continue;
+		}
+
+		if ((int)iProcesses == winner)
+			printf("model found");
+		else if (processStatistics[PORTFOLIO_STATISTIC_QUALITY] == 0)
+			printf("model found later");
+		else
+			printf("%llu unsatisfied clauses", processStatistics[PORTFOLIO_STATISTIC_QUALITY]);
+
+		printf(", %llu restarts, %llu steps, %.3f s\n", processStatistics[PORTFOLIO_STATISTIC_RESTARTS], processStatistics[PORTFOLIO_STATISTIC_STEPS], processStatistics[PORTFOLIO_STATISTIC_MICROSECONDS] / 1e6);
+
+		steps = steps + processStatistics[PORTFOLIO_STATISTIC_STEPS];
+
+		solverFlips = solverFlips + processStatistics[PORTFOLIO_STATISTIC_FLIPS];	/* The totals of the portfolio (see outputResult()) */
+		solverRestarts = solverRestarts + processStatistics[PORTFOLIO_STATISTIC_RESTARTS];
+	}
+
+	printf("c Portfolio: %u processes, %llu steps in total", portfolioProcesses, steps);
+
+	if (winner >= 0)
+		printf(", model found by process %d after %.3f s\n", winner, statistics[winner * PORTFOLIO_STATISTICS + PORTFOLIO_STATISTIC_MICROSECONDS] / 1e6);
+	else
+		printf(", no model found\n");
+}
+
+
+/* portfolioLoad()
+ *
+ * Loads the formula (like solver()) and returns the size
+ * of its image. The lists are kept for portfolioImageWrite(). */
+size_t portfolioLoad(int ***clauseList, int ***varList, int **varScoreList, unsigned short **solution, int **clauseStatusList, int **flippedVariables, char instanceFilePath[], char algoName[]) {
+	readInstanceFile(instanceFilePath, &(*clauseList), &(*varList), &(*varScoreList), &(*solution), &(*clauseStatusList), &(*flippedVariables));
+
+	if (clauseWeightList != NULL)
+		pExit("The portfolio doesn't support weighted instances.\n");
+
+	if (strcmp(algoName, "auto") == 0)	/* The configuration of the process 0 */
+		featuresSelect(&(*clauseList), &(*varList), algoName);
+
+	if (reorderEnabled == true)
+		reorderFormula(&(*clauseList), &(*varList), &(*solution));
+
+	return portfolioImageSize(&(*clauseList), &(*varList));
+}
+
+
+#ifndef PORTFOLIO_MPI
+
+/* portfolioRun()
+ *
+ * The shared memory portfolio: loads the formula, forks
+ * portfolioProcesses processes and waits for them. The
+ * function returns the number of the unsatisfied clauses
+ * of the best process, the model is stored in the
+ * solution. */
+int portfolioRun(unsigned short **solution, char instanceFilePath[], char algoName[], unsigned int maxRestarts, unsigned int randomSeed) {
+	int **clauseList;			/* The loaded formula (see solver()) */
+	int **varList;
+	int *varScoreList;
+	int *clauseStatusList;
+	int *flippedVariables;
+
+	int *image;					/* The shared image of the formula. */
+	size_t imageSize;			/* Number of integers of the image. */
+	size_t sharedSize;			/* Bytes of the shared control, statistics and model. */
+	unsigned char *shared;		/* The shared control, statistics and model. */
+	pid_t processIds[PORTFOLIO_PROCESSES_MAX];	/* The processes. */
+	unsigned int iProcesses;	/* Loop variable for the processes. */
+	unsigned int runningProcesses;	/* Number of processes which didn't end. */
+	pid_t processId;			/* The ended process. */
+	int processStatus;			/* The exit status of the ended process. */
+	int solutionQuality = -1;	/* Return value */
+	int winner;					/* The process which found the model. */
+	bool cancelled = false;		/* Are the processes cancelled by SIGTERM? */
+	struct sigaction signalAction;	/* SIGTERM interrupts waitpid(). */
+
+
+	PROFILE_START(PROFILE_PHASE_LOAD);
+
+	imageSize = portfolioLoad(&clauseList, &varList, &varScoreList, &(*solution), &clauseStatusList, &flippedVariables, instanceFilePath, algoName);
+
+	image = mmap(NULL, sizeof(int) * imageSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (image == MAP_FAILED)
+		pExit("mmap() for the formula image failed: %s\n", strerror(errno));
+
+	portfolioImageWrite(image, &clauseList, &varList);
+
+	if (mprotect(image, sizeof(int) * imageSize, PROT_READ) != 0)	/* No process can change the formula. */
+		perror("mprotect() for the formula image failed");
+
+	solverCleanUp(&clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables);
+
+	PROFILE_STOP(PROFILE_PHASE_LOAD);
+
+
+	sharedSize = sizeof(atomic_int) * 2 + sizeof(unsigned long long) * PORTFOLIO_STATISTICS * portfolioProcesses + sizeof(unsigned short) * (solverNumVars + 1);
+
+	shared = mmap(NULL, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);	/* Initialised with 0 */
+	if (shared == MAP_FAILED)
+		pExit("mmap() for the portfolio control failed: %s\n", strerror(errno));
+
+	portfolioControl = (atomic_int *)shared;
+	portfolioStatistics = (unsigned long long *)(shared + sizeof(atomic_int) * 2);
+	portfolioModel = (unsigned short *)(shared + sizeof(atomic_int) * 2 + sizeof(unsigned long long) * PORTFOLIO_STATISTICS * portfolioProcesses);
+
+	atomic_store(&portfolioControl[1], -1);
+
+
+	fflush(stdout);	/* The processes don't print the buffer again. */
+
+	for (iProcesses = 0; iProcesses < portfolioProcesses; iProcesses++) {
+		processIds[iProcesses] = fork();
+
+		if (processIds[iProcesses] == -1)
+			pExit("fork() for the portfolio process %u failed: %s\n", iProcesses, strerror(errno));
+
+		if (processIds[iProcesses] == 0) {	/* The process of the portfolio */
+			prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+			if (portfolioSearch(iProcesses, image, algoName, maxRestarts, randomSeed, &portfolioStatistics[iProcesses * PORTFOLIO_STATISTICS]) == 0) {
+				winner = -1;
+
+				if (atomic_compare_exchange_strong(&portfolioControl[1], &winner, (int)iProcesses) == true) {	/* The first model */
+					memcpy(portfolioModel, portfolioSolution, sizeof(unsigned short) * (solverNumVars + 1));
+					atomic_store(&portfolioControl[0], 1);
+				}
+			}
+
+			portfolioDetach();
+
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+
+	signalAction.sa_handler = checkpointSignalHandler;
+	signalAction.sa_flags = 0;
+	sigemptyset(&signalAction.sa_mask);
+
+	sigaction(SIGTERM, &signalAction, NULL);
+
+	runningProcesses = portfolioProcesses;
+
+	while (runningProcesses > 0) {
+		processId = waitpid(-1, &processStatus, 0);
+
+		if (processId == -1) {
+			if (errno != EINTR)
+				break;
+
+			if (checkpointRequest == CHECKPOINT_REQUEST_TERMINATE && cancelled == false) {	/* SIGTERM cancels the portfolio. */
+				atomic_store(&portfolioControl[0], 1);
+				cancelled = true;
+			}
+
+			continue;
+		}
+
+		runningProcesses--;
+
+		for (iProcesses = 0; iProcesses < portfolioProcesses; iProcesses++) {
+			if (processIds[iProcesses] == processId && WIFSIGNALED(processStatus))
+				printf("c Portfolio process %u ended by signal %d.\n", iProcesses, WTERMSIG(processStatus));
+		}
+	}
+
+
+	winner = atomic_load(&portfolioControl[1]);
+
+	portfolioPrintStatistics(portfolioStatistics, winner, algoName, randomSeed);
+
+	if (winner >= 0) {
+		memcpy(*solution, portfolioModel, sizeof(unsigned short) * (solverNumVars + 1));
+		solutionQuality = 0;
+	} else {
+		for (iProcesses = 0; iProcesses < portfolioProcesses; iProcesses++) {	/* The best number of unsatisfied clauses */
+			if (portfolioStatistics[iProcesses * PORTFOLIO_STATISTICS + PORTFOLIO_STATISTIC_STATUS] == 1 && (solutionQuality == -1 || (int)portfolioStatistics[iProcesses * PORTFOLIO_STATISTICS + PORTFOLIO_STATISTIC_QUALITY] < solutionQuality))
+				solutionQuality = portfolioStatistics[iProcesses * PORTFOLIO_STATISTICS + PORTFOLIO_STATISTIC_QUALITY];
+		}
+	}
+
+	reorderRestoreSolution(&(*solution));
+
+
+	/* Clean up! */
+	munmap(shared, sharedSize);
+	portfolioControl = NULL;
+
+	munmap(image, sizeof(int) * imageSize);
+
+	reorderCleanUp();
+
+
+	return solutionQuality;
+}
+
+#else
+
+/* portfolioRun()
+ *
+ * The MPI portfolio: the rank 0 loads the formula, the
+ * image is broadcast to the hosts and every rank searches.
+ * The function returns on the rank 0 the number of the
+ * unsatisfied clauses of the best rank and the model of
+ * the lowest rank which found one is stored in the
+ * solution. The other ranks exit. */
+int portfolioRun(unsigned short **solution, char instanceFilePath[], char algoName[], unsigned int maxRestarts, unsigned int randomSeed) {
+	int **clauseList;			/* The loaded formula on the rank 0 (see solver()) */
+	int **varList;
+	int *varScoreList;
+	int *clauseStatusList;
+	int *flippedVariables;
+
+	MPI_Comm hostComm;			/* The ranks of this host. */
+	MPI_Comm leaderComm;		/* The first rank of every host. */
+	MPI_Win imageWindow;		/* The shared window of the image on this host. */
+	int hostRank;				/* The rank on this host. */
+	int *image;					/* The image of the formula. */
+	unsigned long long imageSize = 0;	/* Number of integers of the image. */
+	unsigned long long iImage;	/* Loop variable for the parts of the image. */
+	MPI_Aint windowSize;		/* Bytes of the window. */
+	int displacementUnit;		/* Unit of the window. */
+	unsigned long long statistics[PORTFOLIO_STATISTICS];	/* Statistics of this rank. */
+	unsigned long long *allStatistics = NULL;	/* Statistics of all ranks (rank 0). */
+	int result[2];				/* The number of unsatisfied clauses and the rank (for the best rank). */
+	int best[2];				/* The best result of all ranks. */
+	int cancelSenders;			/* Number of ranks which sent a cancellation. */
+	int iRanks;					/* Loop variable for the ranks. */
+	int solutionQuality;		/* Return value */
+
+
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, portfolioRank, MPI_INFO_NULL, &hostComm);
+	MPI_Comm_rank(hostComm, &hostRank);
+	MPI_Comm_split(MPI_COMM_WORLD, (hostRank == 0 ? 0 : MPI_UNDEFINED), portfolioRank, &leaderComm);
+
+
+	/* The image */
+	if (portfolioRank == 0) {
+		PROFILE_START(PROFILE_PHASE_LOAD);
+
+		imageSize = portfolioLoad(&clauseList, &varList, &varScoreList, &(*solution), &clauseStatusList, &flippedVariables, instanceFilePath, algoName);
+	}
+
+	MPI_Bcast(&imageSize, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+
+	MPI_Win_allocate_shared((hostRank == 0 ? sizeof(int) * imageSize : 0), sizeof(int), MPI_INFO_NULL, hostComm, &image, &imageWindow);
+	MPI_Win_shared_query(imageWindow, 0, &windowSize, &displacementUnit, &image);
+
+	MPI_Win_fence(0, imageWindow);
+
+	if (portfolioRank == 0) {
+		portfolioImageWrite(image, &clauseList, &varList);
+
+		solverCleanUp(&clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables);
+
+		PROFILE_STOP(PROFILE_PHASE_LOAD);
+	}
+
+	if (hostRank == 0) {
+		for (iImage = 0; iImage < imageSize; iImage = iImage + INT_MAX)	/* The count of a broadcast is an int. */
+			MPI_Bcast(&image[iImage], (int)(imageSize - iImage < INT_MAX ? imageSize - iImage : INT_MAX), MPI_INT, 0, leaderComm);
+	}
+
+	MPI_Win_fence(0, imageWindow);
+
+
+	/* The search */
+	result[0] = portfolioSearch(portfolioRank, image, algoName, maxRestarts, randomSeed, statistics);
+	result[1] = portfolioRank;
+
+	if (result[0] == 0 && portfolioCancelled == false) {	/* The others are cancelled. */
+		for (iRanks = 0; iRanks < (int)portfolioProcesses; iRanks++) {
+			if (iRanks != portfolioRank)
+				MPI_Isend(NULL, 0, MPI_INT, iRanks, PORTFOLIO_TAG_CANCEL, MPI_COMM_WORLD, &portfolioCancelRequests[portfolioCancelSent++]);
+		}
+
+		portfolioCancelSent = 1;
+	} else {
+		portfolioCancelSent = 0;
+	}
+
+
+	/* The results */
+	MPI_Allreduce(result, best, 1, MPI_2INT, MPI_MINLOC, MPI_COMM_WORLD);
+	MPI_Allreduce(&portfolioCancelSent, &cancelSenders, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+	for (iRanks = 0; iRanks < cancelSenders - portfolioCancelSent; iRanks++)	/* Every cancellation is received. */
+		MPI_Recv(NULL, 0, MPI_INT, MPI_ANY_SOURCE, PORTFOLIO_TAG_CANCEL, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+	if (portfolioCancelSent == 1)
+		MPI_Waitall(portfolioProcesses - 1, portfolioCancelRequests, MPI_STATUSES_IGNORE);
+
+	if (portfolioRank == 0) {
+		allStatistics = malloc(sizeof(unsigned long long) * PORTFOLIO_STATISTICS * portfolioProcesses);
+		if (allStatistics == NULL)
+			perror("malloc() for the portfolio statistics failed");
+	}
+
+	MPI_Gather(statistics, PORTFOLIO_STATISTICS, MPI_UNSIGNED_LONG_LONG, allStatistics, PORTFOLIO_STATISTICS, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+
+	if (best[0] == 0 && best[1] != 0) {	/* The model is sent to the rank 0. */
+		if (portfolioRank == best[1])
+			MPI_Send(portfolioSolution, solverNumVars + 1, MPI_UNSIGNED_SHORT, 0, PORTFOLIO_TAG_MODEL, MPI_COMM_WORLD);
+		else if (portfolioRank == 0)
+			MPI_Recv(portfolioSolution, solverNumVars + 1, MPI_UNSIGNED_SHORT, best[1], PORTFOLIO_TAG_MODEL, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	}
+
+	solutionQuality = best[0];
+
+
+	if (portfolioRank == 0) {
+		portfolioPrintStatistics(allStatistics, (best[0] == 0 ? best[1] : -1), algoName, randomSeed);
+
+		memcpy(*solution, portfolioSolution, sizeof(unsigned short) * (solverNumVars + 1));
+
+		reorderRestoreSolution(&(*solution));
+
+		free(allStatistics);
+	}
+
+
+	/* Clean up! */
+	portfolioDetach();
+
+	MPI_Win_free(&imageWindow);
+
+	if (leaderComm != MPI_COMM_NULL)
+		MPI_Comm_free(&leaderComm);
+
+	MPI_Comm_free(&hostComm);
+
+	reorderCleanUp();
+
+	if (portfolioRank != 0)
+		exit(EXIT_SUCCESS);
+
+
+	return solutionQuality;
+}
+
+#endif
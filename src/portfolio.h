@@ -0,0 +1,99 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * portfolio.h
+ *
+ *    This is the header file for portfolio.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+
+#ifdef PORTFOLIO_MPI
+#include <mpi.h>
+#endif
+
+#include "solver.h"
+
+
+#define PORTFOLIO_PROCESSES_MAX 256		/* The maximum number of processes of the portfolio (see --portfolio). */
+#define PORTFOLIO_POLL 1024				/* The steps between two checks whether another process found a model. */
+
+/* The statistics of a process. */
+#define PORTFOLIO_STATISTICS 6
+#define PORTFOLIO_STATISTIC_STATUS 0		/* 0 = not finished (crashed), 1 = finished */
+#define PORTFOLIO_STATISTIC_QUALITY 1		/* The number of unsatisfied clauses at the end */
+#define PORTFOLIO_STATISTIC_RESTARTS 2
+#define PORTFOLIO_STATISTIC_STEPS 3
+#define PORTFOLIO_STATISTIC_MICROSECONDS 4
+#define PORTFOLIO_STATISTIC_FLIPS 5
+
+/* The message tags of the MPI portfolio. */
+#define PORTFOLIO_TAG_CANCEL 1
+#define PORTFOLIO_TAG_MODEL 2
+
+
+/* Is the search cancelled, because another process of
+ * the portfolio found a model? The check is only done
+ * every PORTFOLIO_POLL steps. */
+#define PORTFOLIO_CANCELLED() (portfolioActive == true && portfolioPoll() == true)
+
+
+extern unsigned int portfolioProcesses;
+
+extern bool portfolioActive;
+
+extern bool portfolioCancelled;
+
+extern int **portfolioClauseList;
+
+extern int **portfolioVarList;
+
+extern int *portfolioVarScoreList;
+
+extern unsigned short *portfolioSolution;
+
+extern int *portfolioClauseStatusList;
+
+extern int *portfolioFlippedVariables;
+
+
+void portfolioInitialisation(int *argc, char ***argv);
+
+bool portfolioPoll();
+
+size_t portfolioImageSize(int ***clauseList, int ***varList);
+
+void portfolioImageWrite(int *image, int ***clauseList, int ***varList);
+
+void portfolioAttach(int *image);
+
+int portfolioRun(unsigned short **solution, char instanceFilePath[], char algoName[], unsigned int maxRestarts, unsigned int randomSeed);
+
+
+#endif /* PORTFOLIO_H */
@@ -0,0 +1,226 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * profile.c
+ *	
+ * 	This file contains the profiling of the solver phases.
+ *  Each phase is measured with the hardware counters of
+ *  perf_event_open() (cycles, instructions, L1 data and
+ *  last level cache misses and branch misses) and the
+ *  monotonic clock. Without the counters only the time is
+ *  measured. The breakdown is printed at the exit.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "profile.h"
+
+
+/* External variable which is true if the phases are
+ * profiled. */
+bool profileEnabled = false;
+
+
+/* External variables for the hardware counters:
+ * profileCounterFds contains the file descriptors (-1 if
+ * the counter isn't available), the first available
+ * counter is the group leader (profileLeaderFd), so all
+ * counters are read at once. profileCounterIndex contains
+ * for each counter its position in the read values. */
+int profileCounterFds[PROFILE_COUNTERS];
+int profileLeaderFd = -1;
+int profileCounterIndex[PROFILE_COUNTERS];
+unsigned int profileNumCounters = 0;
+
+
+/* External variables for the measurement of each phase:
+ * the number of calls, the total time and counters and
+ * the time and counters at the start of the current
+ * call and whether these counters could be read. */
+unsigned long long profileCalls[PROFILE_PHASES];
+long long profileTime[PROFILE_PHASES];
+uint64_t profileCounts[PROFILE_PHASES][PROFILE_COUNTERS];
+long long profileStartTime[PROFILE_PHASES];
+uint64_t profileStartCounts[PROFILE_PHASES][PROFILE_COUNTERS];
+bool profileStartRead[PROFILE_PHASES];
+
+
+/* profileTimestamp()
+ *
+ * Returns the monotonic time in nanoseconds. */
+long long profileTimestamp() {
+	struct timespec now;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+
+/* profileOpenCounter()
+ *
+ * Opens one hardware counter in the group of the
+ * leader. */
+void profileOpenCounter(unsigned int counter, uint32_t type, uint64_t config) {
+	struct perf_event_attr attr;
+
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = type;
+	attr.size = sizeof(attr);
+	attr.config = config;
+	attr.disabled = (profileLeaderFd == -1);
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+
+	profileCounterFds[counter] = syscall(__NR_perf_event_open, &attr, 0, -1, profileLeaderFd, 0);
+
+	if (profileCounterFds[counter] >= 0) {
+		if (profileLeaderFd == -1)
+			profileLeaderFd = profileCounterFds[counter];
+
+		profileCounterIndex[counter] = profileNumCounters;
+		profileNumCounters++;
+	}
+}
+
+
+/* profileReadCounters()
+ *
+ * Reads all hardware counters into counts. If they can't
+ * be read, counts is set to 0 and false is returned. */
+bool profileReadCounters(uint64_t counts[]) {
+	uint64_t values[PROFILE_COUNTERS + 1];	/* The number of counters and their values. */
+	unsigned int iCounters;					/* Loop variable for the counters. */
+
+
+	if (profileLeaderFd == -1 || read(profileLeaderFd, values, sizeof(values)) < (ssize_t)((profileNumCounters + 1) * sizeof(uint64_t))) {
+		memset(counts, 0, PROFILE_COUNTERS * sizeof(uint64_t));
+		return false;
+	}
+
+	for (iCounters = 0; iCounters < PROFILE_COUNTERS; iCounters++) {
+		if (profileCounterFds[iCounters] >= 0)
+			counts[iCounters] = values[profileCounterIndex[iCounters] + 1];
+	}
+
+	return true;
+}
+
+
+/* profileInitialisation()
+ *
+ * Opens the hardware counters and prints the breakdown at
+ * the exit. */
+void profileInitialisation() {
+	profileOpenCounter(PROFILE_COUNTER_CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	profileOpenCounter(PROFILE_COUNTER_INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	profileOpenCounter(PROFILE_COUNTER_L1_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+	profileOpenCounter(PROFILE_COUNTER_LLC_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+	profileOpenCounter(PROFILE_COUNTER_BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+	if (profileLeaderFd != -1) {
+		ioctl(profileLeaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(profileLeaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+
+	atexit(profileReport);
+}
+
+
+/* profileStart()
+ *
+ * Starts the measurement of a call of the phase. */
+void profileStart(unsigned int phase) {
+	profileStartRead[phase] = profileReadCounters(profileStartCounts[phase]);
+
+	profileStartTime[phase] = profileTimestamp();
+}
+
+
+/* profileStop()
+ *
+ * Adds the measurement of the current call to the phase. */
+void profileStop(unsigned int phase) {
+	long long stopTime = profileTimestamp();	/* The time at the end of the call. */
+	uint64_t stopCounts[PROFILE_COUNTERS];		/* The counters at the end of the call. */
+	bool stopRead;								/* Could the counters be read? */
+	unsigned int iCounters;						/* Loop variable for the counters. */
+
+
+	stopRead = profileReadCounters(stopCounts);
+
+	profileCalls[phase]++;
+	profileTime[phase] = profileTime[phase] + (stopTime - profileStartTime[phase]);
+
+	if (profileStartRead[phase] == false || stopRead == false)
+		return; /* The counters of this call are unknown. */
+
+	for (iCounters = 0; iCounters < PROFILE_COUNTERS; iCounters++) {
+		if (profileCounterFds[iCounters] >= 0)
+			profileCounts[phase][iCounters] = profileCounts[phase][iCounters] + (stopCounts[iCounters] - profileStartCounts[phase][iCounters]);
+	}
+}
+
+
+/* profileFormatCounter()
+ *
+ * Formats the total of a counter or "n/a" if it isn't
+ * available. */
+void profileFormatCounter(char text[], size_t size, unsigned int phase, unsigned int counter) {
+	if (profileCounterFds[counter] >= 0)
+		snprintf(text, size, "%llu", (unsigned long long)profileCounts[phase][counter]);
+	else
+		snprintf(text, size, "n/a");
+}
+
+
+/* profileReport()
+ *
+ * Prints the breakdown of all phases in "c" lines. */
+void profileReport() {
+	char *phaseNames[PROFILE_PHASES] = { "load", "restart", "step", "clause update", "score update" };
+	long long totalTime = 0;		/* The time of all phases. */
+	unsigned int iPhases;			/* Loop variable for the phases. */
+	unsigned int iCounters;			/* Loop variable for the counters. */
+	char counters[PROFILE_COUNTERS][24];	/* The formatted counters. */
+	char ipc[16];					/* The formatted instructions per cycle. */
+
+
+	if (profileEnabled == false)
+		return;
+
+	for (iPhases = 0; iPhases < PROFILE_PHASES; iPhases++)
+		totalTime = totalTime + profileTime[iPhases];
+
+	printf("c Profile%s:\n", (profileLeaderFd == -1 ? " (no hardware counters available)" : ""));
+	printf("c %-13s %12s %12s %7s %16s %16s %6s %14s %14s %14s\n", "phase", "calls", "time [ms]", "time", "cycles", "instructions", "IPC", "L1 misses", "LLC misses", "branch misses");
+
+	for (iPhases = 0; iPhases < PROFILE_PHASES; iPhases++) {
+		for (iCounters = 0; iCounters < PROFILE_COUNTERS; iCounters++)
+			profileFormatCounter(counters[iCounters], sizeof(counters[iCounters]), iPhases, iCounters);
+
+		if (profileCounterFds[PROFILE_COUNTER_CYCLES] >= 0 && profileCounterFds[PROFILE_COUNTER_INSTRUCTIONS] >= 0 && profileCounts[iPhases][PROFILE_COUNTER_CYCLES] > 0)
+			snprintf(ipc, sizeof(ipc), "%.2f", (double)profileCounts[iPhases][PROFILE_COUNTER_INSTRUCTIONS] / profileCounts[iPhases][PROFILE_COUNTER_CYCLES]);
+		else
+			snprintf(ipc, sizeof(ipc), "n/a");
+
+		printf("c %-13s %12llu %12.1f %6.1f%% %16s %16s %6s %14s %14s %14s\n", phaseNames[iPhases], profileCalls[iPhases], profileTime[iPhases] / 1000000.0,
+				(totalTime > 0 ? 100.0 * profileTime[iPhases] / totalTime : 0.0), counters[PROFILE_COUNTER_CYCLES], counters[PROFILE_COUNTER_INSTRUCTIONS], ipc,
+				counters[PROFILE_COUNTER_L1_MISSES], counters[PROFILE_COUNTER_LLC_MISSES], counters[PROFILE_COUNTER_BRANCH_MISSES]);
+	}
+
+	fflush(stdout);
+}
@@ -0,0 +1,73 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * profile.h
+ *
+ *    This is the header file for profile.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "solver.h"
+
+
+/* The profiled phases */
+#define PROFILE_PHASE_LOAD 0			/* Reading (and renumbering) the instance file */
+#define PROFILE_PHASE_RESTART 1			/* The initial solution candidate and the lists of a try */
+#define PROFILE_PHASE_STEP 2			/* The getFlippedVariables() function of the algorithm */
+#define PROFILE_PHASE_CLAUSES 3			/* updateClauseStatusList() */
+#define PROFILE_PHASE_SCORES 4			/* updateVarScoreList() */
+#define PROFILE_PHASES 5
+
+/* The hardware counters */
+#define PROFILE_COUNTER_CYCLES 0
+#define PROFILE_COUNTER_INSTRUCTIONS 1
+#define PROFILE_COUNTER_L1_MISSES 2
+#define PROFILE_COUNTER_LLC_MISSES 3
+#define PROFILE_COUNTER_BRANCH_MISSES 4
+#define PROFILE_COUNTERS 5
+
+
+/* The phase is only measured if the profiling is enabled,
+ * so the hot paths just test one flag otherwise. */
+#define PROFILE_START(PHASE) do { if (profileEnabled == true) profileStart(PHASE); } while (0)
+#define PROFILE_STOP(PHASE) do { if (profileEnabled == true) profileStop(PHASE); } while (0)
+
+
+extern bool profileEnabled;
+
+
+void profileInitialisation();
+
+void profileStart(unsigned int phase);
+
+void profileStop(unsigned int phase);
+
+void profileReport();
+
+
+#endif /* PROFILE_H */
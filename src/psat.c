@@ -35,6 +35,27 @@ void pExit(const char errorMessage[], ...) {
 	exit(EXIT_FAILURE);
 }
 
+/* printModel()
+ *
+ * Prints the values of all variables of the solution in
+ * the "v" lines (see outputModel()). */
+void printModel(unsigned short *solution) {
+	outputModel(solution, solverNumVars);
+}
+
+
+/* printSolution()
+ *
+ * Prints the values of all variables of an satisfying
+ * solution and the "s SATISFIABLE" line. */
+void printSolution(unsigned short *solution) {
+	printModel(solution);
+	outputModelFile(solution, solverNumVars);
+	
+	printf("s SATISFIABLE\n");
+}
+
+
 int compare (const void * a, const void * b)
 {
   return ( *(float*)a - *(float*)b );
@@ -47,20 +68,24 @@ int compare (const void * a, const void * b)
  * program parameters, run the solving process and prints the
  * result. */
 int main(int argc, char* argv[]) {
-	char instanceFilePath[PSAT_INSTANCEFILE_PATH_MAXLENGTH];	/* The path to the instance file. It has to be set through the program argument! */
-	char algoName[PSAT_ALGONAME_MAXLENGTH];  					/* The algorithm name. It has to be set through the program argument! */
+	char instanceFilePath[PSAT_INSTANCEFILE_PATH_MAXLENGTH] = "";	/* The path to the instance file. It has to be set through the program argument! */
+	char algoName[PSAT_ALGONAME_MAXLENGTH] = "";				/* The algorithm name. It has to be set through the program argument! */
 	unsigned int randomSeed = time(NULL); 						/* The random seed. Default is the current unix time step. */
+	unsigned int maxRestarts = S_RESTARTS_MAX;					/* The maximum number of restarts. */
+	bool incrementalMode = false;								/* Is the instance file an iCNF file for the incremental solving? */
 	
 	unsigned int iArgc = 1;	/* 0 is the command to run the program... */
 	
 	/* The founded solution as a array with the
 	 * boolean status of each variable (which are the indices).
 	 * The first index (solution[0]) contains the number
-	 * of literals.
+	 * of literals (see solverNumVars).
 	 */
 	unsigned short *solution;
 	int solutionQuality = -1; 	/* The qulaity of the solution represented by the number of unsatisfied clause ("-1" = the solution is unknown). */
-	unsigned int iSolution; 	/* Loop variable for solution solution */
+
+
+	portfolioInitialisation(&argc, &argv);	/* MPI starts before the arguments are read. */
 
 
 	/* Argument verification. */
@@ -80,14 +105,125 @@ int main(int argc, char* argv[]) {
 	   	   printf("Program parameters:\n");
 	   	   printf("\n");
 	   	   printf("    -f  The path to the instance file (with an maximal length of %d). Required!\n", PSAT_INSTANCEFILE_PATH_MAXLENGTH);
+	   	   printf("        For a \"p wcnf\" instance file the weight of the unsatisfied soft clauses is minimised and every\n");
+	   	   printf("        improvement is printed in an \"o <cost>\" line. Use -n to limit the search.\n");
 	   	   printf("\n");
 	   	   printf("    -a  The algorithm name (with an maximal length of %d). Required!\n", PSAT_ALGONAME_MAXLENGTH);
 	   	   printf("        Currently implemented are:\n");
-	   	   printf("        - Robust Tabu Search (RoTS), name: \"rots\" and\n");
-	   	   printf("        - Iterated Local Search with Simulated Annealing (ILS/SA), name: \"ilssa\".\n");
+	   	   printf("        - Robust Tabu Search (RoTS), name: \"rots\",\n");
+	   	   printf("        - RoTS with self-tuning tabu tenure and stagnation threshold, name: \"arots\"\n");
+	   	   printf("          (the adaptions of each try are summarised in a \"c arots\" line),\n");
+	   	   printf("        - Iterated Local Search with Simulated Annealing (ILS/SA), name: \"ilssa\" and\n");
+	   	   printf("        - automatic selection by the features of the formula, name: \"auto\". It also selects the\n");
+	   	   printf("          restart policy and the multi-flip steps, unless -c or --multiflip is given (see the \"c Auto\" line).\n");
 	   	   printf("\n");
 	   	   printf("    -r  An random seed as a positive integer number between 0 and %u. Default is the current UNIX timestamp.\n", UINT_MAX);
 	   	   printf("\n");
+	   	   printf("    -n  The maximum number of restarts as a positive integer number. Default is %d.\n", S_RESTARTS_MAX);
+	   	   printf("\n");
+	   	   printf("    -s  The initial assignment construction for each restart (with an maximal length of %d).\n", ASSIGNMENT_NAME_MAXLENGTH);
+	   	   printf("        Currently implemented are:\n");
+	   	   printf("        - random assignment, name: \"random\" (default),\n");
+	   	   printf("        - majority of the literal occurrences, name: \"polarity\",\n");
+	   	   printf("        - greedy assignment with unit propagation, name: \"propagation\",\n");
+	   	   printf("        - phase hints from the file given by -p, name: \"hints\" and\n");
+	   	   printf("        - best solution candidate so far with a partial randomisation, name: \"best\".\n");
+	   	   printf("\n");
+	   	   printf("    -p  The path to the phase hints file (with an maximal length of %d) with literals like the \"v\" lines.\n", ASSIGNMENT_HINTSFILE_PATH_MAXLENGTH);
+	   	   printf("\n");
+	   	   printf("    -c  The restart policy, which decides when a try ends (with an maximal length of %d).\n", RESTART_NAME_MAXLENGTH);
+	   	   printf("        Currently implemented are:\n");
+	   	   printf("        - \"fixed\": after %d times the number of variables iterations (default),\n", S_SOLVERITERATIONS_MAXFACTOR);
+	   	   printf("        - \"luby\": after %d times the number of variables multiplied with the Luby sequence,\n", RESTART_LUBY_FACTOR);
+	   	   printf("        - \"geometric\": after %d times the number of variables, growing by %.1f with every restart and\n", RESTART_GEOMETRIC_FACTOR, RESTART_GEOMETRIC_GROWTH);
+	   	   printf("        - \"stagnation\": after %d times the number of variables iterations without an improvement.\n", RESTART_STAGNATION_FACTOR);
+	   	   printf("\n");
+	   	   printf("    -m  The restart mode, which decides where the next try starts (with an maximal length of %d).\n", RESTART_NAME_MAXLENGTH);
+	   	   printf("        Currently implemented are:\n");
+	   	   printf("        - \"random\": a new initial assignment (see -s, default),\n");
+	   	   printf("        - \"perturb\": the best solution candidate so far with %.0f%% of the variables flipped and\n", RESTART_PERTURBATION * 100);
+	   	   printf("        - \"resume\": the current solution candidate, only the algorithm is reinitialised.\n");
+	   	   printf("\n");
+	   	   printf("    -o  Renumber the variables and clauses in the Cuthill-McKee order for a better memory locality.\n");
+	   	   printf("        Not supported with -i and --daemon.\n");
+	   	   printf("\n");
+	   	   printf("    --threads  The number of threads of the search (at most %d, default 1). Formulas with more than\n", PARALLEL_THREADS_MAX);
+	   	   printf("        %d variables or clauses rebuild the lists of a restart, rebuild the scores and scan\n", 2 * PARALLEL_CHUNK_MIN);
+	   	   printf("        the RoTS candidates in parallel. The search is the same for every number of threads.\n");
+	   	   printf("\n");
+	   	   printf("    --multiflip  The maximum number of variables of a multi-flip step (0 = disabled, default). While\n");
+	   	   printf("        there are improving variables, a step flips up to this number of them which share no clause\n");
+	   	   printf("        and no neighbour at once. With --threads, steps with more than %d occurrences of these\n", 2 * PARALLEL_CHUNK_MIN);
+	   	   printf("        variables update the lists in parallel. Not used for \"p wcnf\" instances.\n");
+	   	   printf("\n");
+	   	   printf("    --portfolio  The number of processes of the portfolio (at most %d). Every process searches with its\n", PORTFOLIO_PROCESSES_MAX);
+	   	   printf("        own seed (the random seed + the number of the process) and configuration: the process 0 with the\n");
+	   	   printf("        given algorithm and restart policy, the others with RoTS, adaptive RoTS and ILS/SA and different\n");
+	   	   printf("        restart policies. The first model cancels the others. The formula is shared read-only by all\n");
+	   	   printf("        processes. The statistics of each process are printed in \"c Portfolio\" lines. The MPI build\n");
+	   	   printf("        (make mpi) runs a process on each rank instead (mpirun -np N psat_mpi ...).\n");
+	   	   printf("        Not supported with -i, --checkpoint, --trace and \"p wcnf\" instances.\n");
+	   	   printf("\n");
+	   	   printf("    --daemon  Run as a daemon on the Unix domain socket with this path (with an maximal length of %d).\n", DAEMON_SOCKET_PATH_MAXLENGTH);
+	   	   printf("        Each connection sends one request line:\n");
+	   	   printf("        - \"solve [algo=<name>] [seed=<n>] [restarts=<n>] [timeout=<seconds>] file=<path>\" or with\n");
+	   	   printf("          \"inline=<bytes>\" followed by the formula. The output is the output of psat. -a (default \"auto\"),\n");
+	   	   printf("          -r and -n are the defaults. \"cancel\" on the connection ends the search like SIGTERM,\n");
+	   	   printf("        - \"cancel <id>\" for the request with the id of its \"c Request <id>\" line,\n");
+	   	   printf("        - \"stats\" for the numbers of the cache and the workers and\n");
+	   	   printf("        - \"shutdown\".\n");
+	   	   printf("        The parsed formulas are cached by the hash and the size of their content, so requests for them skip the parsing.\n");
+	   	   printf("        Not supported with -i, -o, --portfolio, --checkpoint, --trace, --models and \"p wcnf\" instances.\n");
+	   	   printf("\n");
+	   	   printf("    --workers  The number of requests the daemon searches at once. Default is the number of processors.\n");
+	   	   printf("\n");
+	   	   printf("    --cache  The maximum number of formulas in the cache of the daemon. Default is %d.\n", DAEMON_CACHE_ENTRIES);
+	   	   printf("\n");
+	   	   printf("    --cache-memory  The maximum MiB of the formulas in the cache of the daemon. Default is %d.\n", DAEMON_CACHE_MEMORY);
+	   	   printf("\n");
+	   	   printf("    --model-file  The path to the model file (with an maximal length of %d). A found model is also\n", OUTPUT_FILE_PATH_MAXLENGTH);
+	   	   printf("        written as a bitset: \"%s\", the number of variables as 8 bytes (little endian) and the\n", OUTPUT_MODEL_MAGIC);
+	   	   printf("        variable v as the bit (v - 1) %% 8 of the byte (v - 1) / 8 (1 = true). The best solution\n");
+	   	   printf("        candidate of an unknown result isn't written, the model file of an earlier run is removed.\n");
+	   	   printf("\n");
+	   	   printf("    --result  The path to the result file (with an maximal length of %d). A record of the run (status,\n", OUTPUT_FILE_PATH_MAXLENGTH);
+	   	   printf("        unsatisfied clauses, cost, flips, restarts, seconds, seed, algorithm and instance) is appended as\n");
+	   	   printf("        a CSV row for a \".csv\" file, otherwise as a JSON object in one line.\n");
+	   	   printf("\n");
+	   	   printf("    --models  The number of models to search (at most %d). After each model the search continues from it\n", MODELS_MAX);
+	   	   printf("        on the loaded formula, but every later model has to differ from it in at least the minimum\n");
+	   	   printf("        Hamming distance of variables. Each model is printed in a \"c Model\" line and \"v\" lines as soon as\n");
+	   	   printf("        it is found. The enumeration ends, if -n restarts find no further model.\n");
+	   	   printf("        Not supported with -i, --portfolio, --daemon, --checkpoint, --model-file and \"p wcnf\" instances.\n");
+	   	   printf("\n");
+	   	   printf("    --models-distance  The minimum Hamming distance between two models. Default is the number of the\n");
+	   	   printf("        variables divided by %d.\n", MODELS_DISTANCE_FRACTION);
+	   	   printf("\n");
+	   	   printf("    -i  Incremental solving: the instance file is in the iCNF format. Clause lines are added to the formula\n");
+	   	   printf("        and each \"a <lit1> ... <litn> 0\" line solves the formula under these assumptions, starting\n");
+	   	   printf("        from the solution candidate of the previous line.\n");
+	   	   printf("\n");
+	   	   printf("    --checkpoint  The path to the checkpoint file (with an maximal length of %d). The search state is\n", CHECKPOINT_FILE_PATH_MAXLENGTH);
+	   	   printf("        written periodically, on SIGUSR1 and on SIGTERM. SIGTERM also prints the best solution\n");
+	   	   printf("        candidate so far and exits (even without a checkpoint file).\n");
+	   	   printf("\n");
+	   	   printf("    --checkpoint-interval  The number of seconds between two periodic checkpoints (0 = only on signals).\n");
+	   	   printf("        Default is %d.\n", CHECKPOINT_INTERVAL);
+	   	   printf("\n");
+	   	   printf("    --resume  Continue the search from the checkpoint file. The instance file and the other parameters\n");
+	   	   printf("        must be the same as before.\n");
+	   	   printf("\n");
+	   	   printf("    --profile  Print the time and the hardware counters (cycles, instructions, L1 and LLC misses and\n");
+	   	   printf("        branch misses) of each solver phase in \"c\" lines at the exit. Without perf_event_open()\n");
+	   	   printf("        only the time is measured. The measurement slows down the solver.\n");
+	   	   printf("\n");
+	   	   printf("    --trace  The path to the binary flip trace file (with an maximal length of %d). Every flip is\n", TRACE_FILE_PATH_MAXLENGTH);
+	   	   printf("        recorded with its reason and the quality after the step. Use tools/tracedecode for CSV.\n");
+	   	   printf("\n");
+	   	   printf("    --trace-sample  Record only every n-th step. Default is 1.\n");
+	   	   printf("\n");
+	   	   printf("    --trace-window  Record only the steps \"<first step>:<last step>\" (counted over all tries from 1).\n");
+	   	   printf("\n");
 	   	   printf("    -h  This page.\n");
 	   		
 		   return EXIT_SUCCESS;
@@ -125,40 +261,307 @@ int main(int argc, char* argv[]) {
 	   			pExit("You must specify an random seed after the -r parameter!\n");
 	   		}
 	   }
+	   
+	   if (strcmp(argv[iArgc], "-n") == 0) { /* The maximum number of restarts */
+	   		if ((iArgc + 1) < argc) {
+	   			if (atoi(argv[(iArgc + 1)]) > 0)
+	   				maxRestarts = atoi(argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The maximum number of restarts has to be an positive integer number!\n");
+	   		} else {
+	   			pExit("You must specify the maximum number of restarts after the -n parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "-s") == 0) { /* The initial assignment construction */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= ASSIGNMENT_NAME_MAXLENGTH && assignmentIsKnown(argv[(iArgc + 1)]) == true)
+	   				strcpy(assignmentName, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The initial assignment construction \"%s\" is unknown!\n", argv[(iArgc + 1)]);
+	   		} else {
+	   			pExit("You must specify an initial assignment construction after the -s parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "-p") == 0) { /* The phase hints file path */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= ASSIGNMENT_HINTSFILE_PATH_MAXLENGTH)
+	   				strcpy(assignmentHintsFilePath, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The path to the phase hints file can have an maximal length of %d!\n", ASSIGNMENT_HINTSFILE_PATH_MAXLENGTH);
+	   		} else {
+	   			pExit("You must specify an path to the phase hints file after the -p parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "-c") == 0) { /* The restart policy */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= RESTART_NAME_MAXLENGTH && restartIsKnownPolicy(argv[(iArgc + 1)]) == true) {
+	   				strcpy(restartPolicyName, argv[(iArgc + 1)]);
+	   				restartPolicyGiven = true;
+	   			} else {
+	   				pExit("The restart policy \"%s\" is unknown!\n", argv[(iArgc + 1)]);
+	   			}
+	   		} else {
+	   			pExit("You must specify an restart policy after the -c parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "-m") == 0) { /* The restart mode */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= RESTART_NAME_MAXLENGTH && restartIsKnownMode(argv[(iArgc + 1)]) == true)
+	   				strcpy(restartModeName, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The restart mode \"%s\" is unknown!\n", argv[(iArgc + 1)]);
+	   		} else {
+	   			pExit("You must specify an restart mode after the -m parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "-o") == 0) { /* Renumbering */
+	   		reorderEnabled = true;
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--threads") == 0) { /* The threads of the search */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &parallelThreads) == 1 && parallelThreads >= 1 && parallelThreads <= PARALLEL_THREADS_MAX) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the number of threads (1 - %d) after the --threads parameter!\n", PARALLEL_THREADS_MAX);
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--multiflip") == 0) { /* The multi-flip steps */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &multiflipMax) == 1) {
+	   			multiflipGiven = true;
+	   		} else {
+	   			pExit("You must specify the maximum number of variables of a multi-flip step after the --multiflip parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--portfolio") == 0) { /* The processes of the portfolio */
+#ifdef PORTFOLIO_MPI
+	   		pExit("The MPI build uses the number of ranks of mpirun as the number of processes of the portfolio!\n");
+#endif
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &portfolioProcesses) == 1 && portfolioProcesses >= 1 && portfolioProcesses <= PORTFOLIO_PROCESSES_MAX) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the number of processes (1 - %d) after the --portfolio parameter!\n", PORTFOLIO_PROCESSES_MAX);
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--model-file") == 0) { /* The model file path */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= OUTPUT_FILE_PATH_MAXLENGTH)
+	   				strcpy(outputModelFilePath, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The path to the model file can have an maximal length of %d!\n", OUTPUT_FILE_PATH_MAXLENGTH);
+	   		} else {
+	   			pExit("You must specify an path to the model file after the --model-file parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--result") == 0) { /* The result file path */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= OUTPUT_FILE_PATH_MAXLENGTH)
+	   				strcpy(outputResultFilePath, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The path to the result file can have an maximal length of %d!\n", OUTPUT_FILE_PATH_MAXLENGTH);
+	   		} else {
+	   			pExit("You must specify an path to the result file after the --result parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--daemon") == 0) { /* The socket path of the daemon */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= DAEMON_SOCKET_PATH_MAXLENGTH)
+	   				strcpy(daemonSocketPath, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The path to the socket can have an maximal length of %d!\n", DAEMON_SOCKET_PATH_MAXLENGTH);
+	   		} else {
+	   			pExit("You must specify an path to the socket after the --daemon parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--workers") == 0) { /* The workers of the daemon */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &daemonWorkers) == 1 && daemonWorkers >= 1 && daemonWorkers <= DAEMON_WORKERS_MAX) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the number of workers (1 - %d) after the --workers parameter!\n", DAEMON_WORKERS_MAX);
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--cache") == 0) { /* The formulas of the cache */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &daemonCacheEntries) == 1 && daemonCacheEntries <= DAEMON_CACHE_MAX) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the number of formulas (0 - %d) after the --cache parameter!\n", DAEMON_CACHE_MAX);
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--cache-memory") == 0) { /* The MiB of the cache */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &daemonCacheMemory) == 1) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the MiB of the cache after the --cache-memory parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--models") == 0) { /* The number of models */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &modelsMax) == 1 && modelsMax >= 1 && modelsMax <= MODELS_MAX) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the number of models (1 - %d) after the --models parameter!\n", MODELS_MAX);
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--models-distance") == 0) { /* The minimum Hamming distance of the models */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &modelsDistance) == 1 && modelsDistance >= 1) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify an positive integer number after the --models-distance parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "-i") == 0) { /* Incremental solving */
+	   		incrementalMode = true;
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--checkpoint") == 0) { /* The checkpoint file path */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= CHECKPOINT_FILE_PATH_MAXLENGTH)
+	   				strcpy(checkpointFilePath, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The path to the checkpoint file can have an maximal length of %d!\n", CHECKPOINT_FILE_PATH_MAXLENGTH);
+	   		} else {
+	   			pExit("You must specify an path to the checkpoint file after the --checkpoint parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--checkpoint-interval") == 0) { /* The seconds between two periodic checkpoints */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &checkpointInterval) == 1) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the number of seconds after the --checkpoint-interval parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--resume") == 0) { /* Resume from the checkpoint file */
+	   		checkpointResume = true;
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--profile") == 0) { /* Profiling of the solver phases */
+	   		profileEnabled = true;
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--trace") == 0) { /* The trace file path */
+	   		if ((iArgc + 1) < argc) {
+	   			if (strlen(argv[(iArgc + 1)]) <= TRACE_FILE_PATH_MAXLENGTH)
+	   				strcpy(traceFilePath, argv[(iArgc + 1)]);
+	   			else
+	   				pExit("The path to the trace file can have an maximal length of %d!\n", TRACE_FILE_PATH_MAXLENGTH);
+	   		} else {
+	   			pExit("You must specify an path to the trace file after the --trace parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--trace-sample") == 0) { /* Record every n-th step */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%u", &traceSample) == 1 && traceSample > 0) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify an positive integer number after the --trace-sample parameter!\n");
+	   		}
+	   }
+	   
+	   if (strcmp(argv[iArgc], "--trace-window") == 0) { /* Record only the steps of the window */
+	   		if ((iArgc + 1) < argc && sscanf(argv[(iArgc + 1)], "%llu:%llu", &traceWindowStart, &traceWindowEnd) == 2 && traceWindowStart <= traceWindowEnd) {
+	   			/* Nothing to do */
+	   		} else {
+	   			pExit("You must specify the window as \"<first step>:<last step>\" after the --trace-window parameter!\n");
+	   		}
+	   }
 	   	   
 	   iArgc++;
     }
     
+    if ((incrementalMode == true || strlen(daemonSocketPath) > 0) && (strlen(outputModelFilePath) > 0 || strlen(outputResultFilePath) > 0)) pExit("The model and the result file are only written for a single formula (not with -i and --daemon).\n");
+
+    if (strlen(daemonSocketPath) > 0) {	/* The requests give the instance files. */
+    	if (incrementalMode == true || reorderEnabled == true || portfolioProcesses > 1 || strlen(checkpointFilePath) > 0 || strlen(traceFilePath) > 0 || modelsMax > 0) pExit("The daemon doesn't support the incremental solving (-i), the renumbering (-o), the portfolio, checkpoints, traces and the enumeration of models.\n");
+
+    	daemonRun((strlen(algoName) > 0 ? algoName : "auto"), maxRestarts, randomSeed);
+
+    	return EXIT_SUCCESS;
+    }
+
     if (strlen(instanceFilePath) == 0 || strlen(algoName) == 0) pExit("You must specify at least the instance file path (-f) and the algorithm name (-a). Use \"%s -h\" for more information.\n", argv[0]); /* TO-DO: Usage description */
 
+    if (strcmp(assignmentName, "hints") == 0 && strlen(assignmentHintsFilePath) == 0) pExit("You must specify the phase hints file (-p) for the initial assignment construction \"hints\".\n");
+
+    if (checkpointResume == true && strlen(checkpointFilePath) == 0) pExit("You must specify the checkpoint file (--checkpoint) to resume the search.\n");
+
+    if (incrementalMode == true && strlen(checkpointFilePath) > 0) pExit("The incremental solving (-i) doesn't support checkpoints.\n");
+
+    if (incrementalMode == true && reorderEnabled == true) pExit("The incremental solving (-i) doesn't support the renumbering (-o).\n");
+
+    if (portfolioProcesses > 1 && (incrementalMode == true || strlen(checkpointFilePath) > 0 || strlen(traceFilePath) > 0)) pExit("The portfolio doesn't support the incremental solving (-i), checkpoints and traces.\n");
+
+    if (modelsMax > 0 && (incrementalMode == true || portfolioProcesses > 1 || strlen(checkpointFilePath) > 0 || strlen(outputModelFilePath) > 0)) pExit("The enumeration of models (--models) doesn't support the incremental solving (-i), the portfolio, checkpoints and the model file.\n");
+
     
     /* Get a solution */
-    srand(randomSeed);
+    outputStart(instanceFilePath, algoName, randomSeed);
+
+    checkpointSeed(randomSeed);
     
-    solutionQuality = solver(&solution, instanceFilePath, algoName);
+    if (profileEnabled == true)
+    	profileInitialisation();
+    
+    if (parallelThreads > 1 && portfolioProcesses == 1)	/* Every process of the portfolio starts its own threads. */
+    	parallelInitialisation();
+    
+    if (incrementalMode == true) {
+    	incrementalRun(instanceFilePath, algoName, maxRestarts);
+    	
+    	return EXIT_SUCCESS;
+    }
+    
+    checkpointInitialisation();
+    
+    if (modelsMax > 0) {
+    	modelsRun(instanceFilePath, algoName, maxRestarts);
+    	
+    	return EXIT_SUCCESS;
+    }
+    
+    if (portfolioProcesses > 1)
+    	solutionQuality = portfolioRun(&solution, instanceFilePath, algoName, maxRestarts, randomSeed);
+    else
+    	solutionQuality = solver(&solution, instanceFilePath, algoName, maxRestarts);
 
 
     /* Print the best known solution */
-    if (solutionQuality == -1) {		/* The solution is unknown. */
+    if (weightedMode == true) {		/* The weighted mode prints the best solution which satisfies all hard clauses. */
+		if (weightedBestCost == LLONG_MAX) {
+			printf("s UNKNOWN\n");
+		} else {
+			printf("s %s\n", (weightedBestCost == 0 ? "OPTIMUM FOUND" : "SATISFIABLE"));
+			printModel(solution);
+			outputModelFile(solution, solverNumVars);
+		}
+	} else if (solutionQuality == -1) {		/* The solution is unknown. */
 		printf("The solution is unknown.\n");
 	} else if (solutionQuality == 0) {	/* The instance was satisfiable. */
-		printf("v ");
-		for (iSolution = 1; iSolution <= solution[0]; iSolution++) {
-			if (solution[iSolution] == 0) {
-				printf("-%d ", iSolution);
-			} else if (solution[iSolution] == 1) {
-				printf("%d ", iSolution);
-			} else {
-				pExit("The solution array has at position %d a wrong value of %d.\n", iSolution, solution[iSolution]);
-			} 
-		}
-		printf("0\n");
-		
-		printf("s SATISFIABLE\n");
+		printSolution(solution);
 	} else { 							/* The termination criterium was reached. */
 		/*printf("s UNSATISFIABLE\n");*/
 	}
 
+	if (weightedMode == true)
+		outputResult((weightedBestCost == LLONG_MAX ? "UNKNOWN" : (weightedBestCost == 0 ? "OPTIMUM FOUND" : "SATISFIABLE")), solutionQuality, (weightedBestCost == LLONG_MAX ? -1 : weightedBestCost));
+	else
+		outputResult((solutionQuality == 0 ? "SATISFIABLE" : "UNKNOWN"), solutionQuality, -1);
+
 
     /* Clean up! */
     free(solution);
@@ -30,6 +30,9 @@
 #include <limits.h>
 
 #include "solver.h"
+#include "incremental.h"
+#include "daemon.h"
+#include "models.h"
 
 
 #define PSAT_INSTANCEFILE_PATH_MAXLENGTH 255 	/* The maximum length of the instance file path */
@@ -38,4 +41,8 @@
 
 void pExit(const char errorMessage[], ...);
 
+void printModel(unsigned short *solution);
+
+void printSolution(unsigned short *solution);
+
 #endif /* PSAT_H */
\ No newline at end of file
@@ -0,0 +1,289 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * reorder.c
+ *	
+ * 	This file contains the renumbering of the variables and
+ *  clauses in the Cuthill-McKee order. Neighbouring
+ *  variables (which occur in the same clauses) and their
+ *  clauses get close numbers, so the lists reached from the
+ *  occurrences of one variable are close in memory.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "reorder.h"
+
+
+/* External variable which is true if the formula
+ * is renumbered after loading. */
+bool reorderEnabled = false;
+
+
+/* External variables for the variable numbering.
+ * reorderOldToNew contains for each original
+ * variable its new number, reorderNewToOld the
+ * inverse mapping. Both are NULL if the formula is
+ * not renumbered. The index 0 contains the number
+ * of variables. */
+unsigned int *reorderOldToNew = NULL;
+unsigned int *reorderNewToOld = NULL;
+
+
+/* External variable for the varList during the
+ * sorting of the neighbours by their degree. */
+int **reorderVarList;
+
+
+/* reorderCompareDegree()
+ *
+ * Compares two variables by their number of
+ * occurrences for qsort(). */
+int reorderCompareDegree(const void *a, const void *b) {
+	return reorderVarList[*(unsigned int *)a][0] - reorderVarList[*(unsigned int *)b][0];
+}
+
+
+/* reorderVariable()
+ *
+ * Returns the number of the original variable in the
+ * renumbered formula. */
+unsigned int reorderVariable(unsigned int var) {
+	if (reorderOldToNew == NULL)
+		return var;
+
+	return reorderOldToNew[var];
+}
+
+
+/* reorderFormula()
+ *
+ * Renumbers the variables and clauses of the formula in the
+ * Cuthill-McKee order: A breadth-first search over the
+ * variables starts at an unvisited variable with the fewest
+ * occurrences. The neighbours of each variable are visited
+ * in the order of their number of occurrences and each
+ * clause gets its number when it is reached first. The
+ * clauseList, varList (and clauseWeightList) are rebuilt
+ * in the new order. */
+void reorderFormula(int ***clauseList, int ***varList, unsigned short **solution) {
+	unsigned int numVars = (*varList)[0][0];		/* Number of variables. */
+	unsigned int numClauses = (*clauseList)[0][0];	/* Number of clauses. */
+
+	unsigned int *sortedVars;		/* All variables sorted by their number of occurrences. */
+	unsigned int *clauseNewToOld;	/* For each new clause number the original clause. */
+	unsigned short *visitedClause;	/* For each clause 1 if it is already numbered. */
+	unsigned int *neighbours;		/* The unvisited neighbours of the current variable. */
+	unsigned int numNeighbours;		/* Number of neighbours. */
+	long long *weights;				/* The renumbered clauseWeightList. */
+
+	unsigned int iSortedVars;		/* Loop variable for sortedVars. */
+	unsigned int queueHead = 1;		/* Next variable of the breadth-first search in reorderNewToOld. */
+	unsigned int numNumberedVars = 0;		/* Number of numbered variables (also the end of the queue). */
+	unsigned int numNumberedClauses = 0;	/* Number of numbered clauses. */
+	unsigned int iVarListClause;	/* Loop variable for the occurrences of a variable. */
+	unsigned int iClauseListLit;	/* Loop variable for the literals of a clause. */
+	unsigned int var;				/* Current variable of the breadth-first search. */
+	unsigned int clause;			/* Current clause. */
+	unsigned int neighbour;			/* Current neighbour. */
+	int curLiteral;					/* Current literal. */
+
+	int **newClauseList;			/* The renumbered clauseList. */
+	int **newVarList;				/* The renumbered varList. */
+	unsigned int iClauseList;		/* Loop variable for the clauseList. */
+	unsigned int iVarList;			/* Loop variable for the varList. */
+
+
+	reorderOldToNew = calloc((numVars + 1), sizeof(unsigned int));
+	reorderNewToOld = calloc((numVars + 1), sizeof(unsigned int));
+	sortedVars = malloc((numVars + 1) * sizeof(unsigned int));
+	clauseNewToOld = malloc((numClauses + 1) * sizeof(unsigned int));
+	visitedClause = calloc((numClauses + 1), sizeof(unsigned short));
+	neighbours = malloc((numVars + 1) * sizeof(unsigned int));
+	if (reorderOldToNew == NULL || reorderNewToOld == NULL || sortedVars == NULL || clauseNewToOld == NULL || visitedClause == NULL || neighbours == NULL)
+		perror("malloc() for reorderFormula() failed");
+
+	reorderOldToNew[0] = numVars;
+	reorderNewToOld[0] = numVars;
+
+
+	/* Breadth-first search */
+	reorderVarList = *varList;
+
+	for (iSortedVars = 1; iSortedVars <= numVars; iSortedVars++)
+		sortedVars[iSortedVars] = iSortedVars;
+
+	qsort(&sortedVars[1], numVars, sizeof(unsigned int), reorderCompareDegree);
+
+	for (iSortedVars = 1; iSortedVars <= numVars; iSortedVars++) {	/* Each unvisited variable starts a new component. */
+		if (reorderOldToNew[sortedVars[iSortedVars]] != 0)
+			continue;
+
+		numNumberedVars++;
+		reorderOldToNew[sortedVars[iSortedVars]] = numNumberedVars;
+		reorderNewToOld[numNumberedVars] = sortedVars[iSortedVars];
+
+		while (queueHead <= numNumberedVars) {
+			var = reorderNewToOld[queueHead];
+			queueHead++;
+
+			numNeighbours = 0;
+
+			for (iVarListClause = 1; iVarListClause <= (*varList)[var][0]; iVarListClause++) {
+				clause = ((*varList)[var][iVarListClause] > 0 ? (*varList)[var][iVarListClause] : ((*varList)[var][iVarListClause] * -1));
+
+				if (visitedClause[clause] == 1)
+					continue;
+
+				visitedClause[clause] = 1;
+				numNumberedClauses++;
+				clauseNewToOld[numNumberedClauses] = clause;
+
+				for (iClauseListLit = 1; iClauseListLit <= (*clauseList)[clause][0]; iClauseListLit++) {
+					curLiteral = (*clauseList)[clause][iClauseListLit];
+					neighbour = (curLiteral > 0 ? curLiteral : (curLiteral * -1));
+
+					if (reorderOldToNew[neighbour] == 0) {
+						reorderOldToNew[neighbour] = numVars + 1;	/* Marked as queued, numbered after sorting. */
+						neighbours[numNeighbours] = neighbour;
+						numNeighbours++;
+					}
+				}
+			}
+
+			qsort(neighbours, numNeighbours, sizeof(unsigned int), reorderCompareDegree);
+
+			for (neighbour = 0; neighbour < numNeighbours; neighbour++) {
+				numNumberedVars++;
+				reorderOldToNew[neighbours[neighbour]] = numNumberedVars;
+				reorderNewToOld[numNumberedVars] = neighbours[neighbour];
+			}
+		}
+	}
+
+	for (iClauseList = 1; iClauseList <= numClauses; iClauseList++) {	/* Empty clauses are not reached by the search. */
+		if (visitedClause[iClauseList] == 0) {
+			numNumberedClauses++;
+			clauseNewToOld[numNumberedClauses] = iClauseList;
+		}
+	}
+
+
+	/* Rebuild the clauseList in the new order */
+	newClauseList = growList(NULL, 0, (numClauses + 1), sizeof(int *));
+	newClauseList[0] = (*clauseList)[0];
+
+	for (iClauseList = 1; iClauseList <= numClauses; iClauseList++) {
+		clause = clauseNewToOld[iClauseList];
+
+		newClauseList[iClauseList] = malloc(((*clauseList)[clause][0] + 1) * sizeof(int));
+		if (newClauseList[iClauseList] == NULL)
+			perror("malloc() for the renumbered clauseList failed");
+
+		newClauseList[iClauseList][0] = (*clauseList)[clause][0];
+
+		for (iClauseListLit = 1; iClauseListLit <= (*clauseList)[clause][0]; iClauseListLit++) {
+			curLiteral = (*clauseList)[clause][iClauseListLit];
+			newClauseList[iClauseList][iClauseListLit] = (curLiteral > 0 ? (int)reorderOldToNew[curLiteral] : ((int)reorderOldToNew[(curLiteral * -1)] * -1));
+		}
+
+		free((*clauseList)[clause]);
+	}
+
+	free(*clauseList);
+	*clauseList = newClauseList;
+
+
+	/* Rebuild the varList in the new order */
+	newVarList = growList(NULL, 0, (numVars + 1), sizeof(int *));
+	newVarList[0] = (*varList)[0];
+
+	for (iVarList = 1; iVarList <= numVars; iVarList++) {
+		newVarList[iVarList] = calloc(listCapacity((*varList)[reorderNewToOld[iVarList]][0] + 1), sizeof(int));
+		if (newVarList[iVarList] == NULL)
+			perror("calloc() for the renumbered varList failed");
+	}
+
+	for (iVarList = 1; iVarList <= numVars; iVarList++)
+		free((*varList)[iVarList]);
+
+	free(*varList);
+	*varList = newVarList;
+
+	for (iClauseList = 1; iClauseList <= numClauses; iClauseList++) {	/* The occurrences are sorted by the new clause numbers. */
+		for (iClauseListLit = 1; iClauseListLit <= (*clauseList)[iClauseList][0]; iClauseListLit++) {
+			curLiteral = (*clauseList)[iClauseList][iClauseListLit];
+			var = (curLiteral > 0 ? curLiteral : (curLiteral * -1));
+
+			(*varList)[var][0] = (*varList)[var][0] + 1;
+			(*varList)[var][(*varList)[var][0]] = (curLiteral > 0 ? (int)iClauseList : ((int)iClauseList * -1));
+		}
+	}
+
+
+	/* Renumber the clause weights */
+	if (clauseWeightList != NULL) {
+		weights = growList(NULL, 0, (numClauses + 1), sizeof(long long));
+		weights[0] = clauseWeightList[0];
+
+		for (iClauseList = 1; iClauseList <= numClauses; iClauseList++)
+			weights[iClauseList] = clauseWeightList[clauseNewToOld[iClauseList]];
+
+		free(clauseWeightList);
+		clauseWeightList = weights;
+	}
+
+	memset(&(*solution)[1], 0, numVars * sizeof(unsigned short));
+
+
+	/* Clean up! */
+	free(sortedVars);
+	free(clauseNewToOld);
+	free(visitedClause);
+	free(neighbours);
+}
+
+
+/* reorderRestoreSolution()
+ *
+ * Maps the solution back to the original numbering of the
+ * variables. */
+void reorderRestoreSolution(unsigned short **solution) {
+	unsigned short *restoredSolution;	/* The solution in the original numbering. */
+	unsigned int iVarList;				/* Loop variable for the variables. */
+
+
+	if (reorderNewToOld == NULL)
+		return;
+
+	restoredSolution = growList(NULL, 0, (reorderNewToOld[0] + 1), sizeof(unsigned short));
+	restoredSolution[0] = (*solution)[0];
+
+	for (iVarList = 1; iVarList <= reorderNewToOld[0]; iVarList++)
+		restoredSolution[reorderNewToOld[iVarList]] = (*solution)[iVarList];
+
+	free(*solution);
+	*solution = restoredSolution;
+}
+
+
+/* reorderCleanUp()
+ *
+ * Deallocate memory which was used by the renumbering. */
+void reorderCleanUp() {
+	free(reorderOldToNew);
+	reorderOldToNew = NULL;
+
+	free(reorderNewToOld);
+	reorderNewToOld = NULL;
+}
\ No newline at end of file
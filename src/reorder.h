@@ -0,0 +1,44 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * reorder.h
+ *
+ *    This is the header file for reorder.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "solver.h"
+
+
+extern bool reorderEnabled;
+
+
+unsigned int reorderVariable(unsigned int var);
+
+void reorderFormula(int ***clauseList, int ***varList, unsigned short **solution);
+
+void reorderRestoreSolution(unsigned short **solution);
+
+void reorderCleanUp();
+
+
+#endif /* REORDER_H */
\ No newline at end of file
@@ -0,0 +1,187 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * restart.c
+ *	
+ * 	This file contains the restart scheduler: the restart
+ *  policies, which decide when a try ends, and the restart
+ *  modes, which decide where the next try starts.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "restart.h"
+
+
+/* External variable for the name of the restart policy.
+ * Currently implemented are:
+ * - "fixed": every try ends after S_SOLVERITERATIONS_MAXFACTOR
+ *   multiplied with the number of variables iterations,
+ * - "luby", "geometric" and "stagnation" (see restart.h). */
+char restartPolicyName[RESTART_NAME_MAXLENGTH + 1] = "fixed";
+
+/* External variable which is true, if the restart policy
+ * was given by -c (see featuresSelect()). */
+bool restartPolicyGiven = false;
+
+/* External variable for the name of the restart mode.
+ * Currently implemented are:
+ * - "random": a new initial assignment (see
+ *   assignmentGenerate()),
+ * - "perturb": the best solution candidate so far with
+ *   RESTART_PERTURBATION of the variables flipped and
+ * - "resume": the current solution candidate, only the
+ *   algorithm is reinitialised. */
+char restartModeName[RESTART_NAME_MAXLENGTH + 1] = "random";
+
+
+/* External variables for the stagnation policy: the
+ * best quality of the current try and the solver
+ * iteration of its last improvement. */
+long long restartTryBestQuality;
+unsigned int restartLastImprovement;
+
+
+/* restartIsKnownPolicy()
+ *
+ * Returns true if a restart policy with this name
+ * exists. */
+bool restartIsKnownPolicy(char name[]) {
+	return (strcmp(name, "fixed") == 0 || strcmp(name, "luby") == 0 || strcmp(name, "geometric") == 0 || strcmp(name, "stagnation") == 0);
+}
+
+
+/* restartIsKnownMode()
+ *
+ * Returns true if a restart mode with this name
+ * exists. */
+bool restartIsKnownMode(char name[]) {
+	return (strcmp(name, "random") == 0 || strcmp(name, "perturb") == 0 || strcmp(name, "resume") == 0);
+}
+
+
+/* restartLuby()
+ *
+ * Returns the element with the index (starting with 0)
+ * of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ... */
+unsigned int restartLuby(unsigned int index) {
+	unsigned int size;		/* Size of the smallest complete subsequence, which contains the index. */
+	unsigned int exponent;	/* The exponent of its last element. */
+
+
+	for (size = 1, exponent = 0; size < index + 1; exponent++)
+		size = 2 * size + 1;
+
+	while (size - 1 != index) {
+		size = (size - 1) >> 1;
+		exponent--;
+		index = index % size;
+	}
+
+	return 1U << exponent;
+}
+
+
+/* restartCutoff()
+ *
+ * Returns the maximum number of solver iterations of the
+ * try after restartsCount restarts. */
+unsigned int restartCutoff(unsigned int restartsCount, int ***varList) {
+	double cutoff;	/* The cutoff, which can exceed the range of an unsigned int. */
+
+
+	restartTryBestQuality = LLONG_MAX;
+	restartLastImprovement = 0;
+
+	if (strcmp(restartPolicyName, "luby") == 0)
+		cutoff = (double)RESTART_LUBY_FACTOR * (*varList)[0][0] * restartLuby(restartsCount);
+	else if (strcmp(restartPolicyName, "geometric") == 0)
+		cutoff = (double)RESTART_GEOMETRIC_FACTOR * (*varList)[0][0] * pow(RESTART_GEOMETRIC_GROWTH, restartsCount);
+	else if (strcmp(restartPolicyName, "stagnation") == 0)
+		cutoff = UINT_MAX;
+	else
+		cutoff = (double)S_SOLVERITERATIONS_MAXFACTOR * (*varList)[0][0];
+
+	return (cutoff < UINT_MAX ? (unsigned int)cutoff : UINT_MAX);
+}
+
+
+/* restartStagnation()
+ *
+ * Returns true if the stagnation policy ends the try,
+ * because the quality wasn't improved for
+ * RESTART_STAGNATION_FACTOR multiplied with the number of
+ * variables iterations. */
+bool restartStagnation(unsigned int solverIterations, long long quality, int ***varList) {
+	if (quality < restartTryBestQuality) {
+		restartTryBestQuality = quality;
+		restartLastImprovement = solverIterations;
+
+		return false;
+	}
+
+	return ((solverIterations - restartLastImprovement) > ((unsigned int)RESTART_STAGNATION_FACTOR * (*varList)[0][0]));
+}
+
+
+/* restartGenerate()
+ *
+ * Sets the solution candidate for the try after
+ * restartsCount restarts with the restart mode. Returns
+ * false if the current solution candidate is resumed, so
+ * the clauseStatusList and the scores are still valid. */
+bool restartGenerate(unsigned int restartsCount, unsigned short **solution, int ***clauseList, int ***varList) {
+	unsigned int iPerturbation;	/* Loop variable for the perturbation. */
+	unsigned int var;			/* Perturbed variable. */
+
+
+	if (restartsCount > 0 && strcmp(restartModeName, "resume") == 0)
+		return false;
+
+	if (restartsCount > 0 && strcmp(restartModeName, "perturb") == 0 && assignmentBestQuality < INT_MAX) {
+		memcpy(&(*solution)[1], &assignmentBestSolution[1], (*varList)[0][0] * sizeof(unsigned short));
+
+		for (iPerturbation = 0; iPerturbation < (RESTART_PERTURBATION * (*varList)[0][0]) + 1; iPerturbation++) {
+			var = rand() % (*varList)[0][0] + 1;
+
+			if (fixedVariables[var] == 0)
+				(*solution)[var] = 1 - (*solution)[var];
+		}
+
+		return true;
+	}
+
+	assignmentGenerate(restartsCount, &(*solution), &(*clauseList), &(*varList));
+
+	return true;
+}
+
+
+/* restartWriteCheckpoint()
+ *
+ * Writes the state of the stagnation policy into the
+ * checkpoint file. */
+void restartWriteCheckpoint(FILE *checkpointFileHandle) {
+	checkpointWriteData(&restartTryBestQuality, sizeof(restartTryBestQuality), checkpointFileHandle);
+	checkpointWriteData(&restartLastImprovement, sizeof(restartLastImprovement), checkpointFileHandle);
+}
+
+
+/* restartReadCheckpoint()
+ *
+ * Reads the state of the stagnation policy from the
+ * checkpoint file. */
+void restartReadCheckpoint(FILE *checkpointFileHandle) {
+	checkpointReadData(&restartTryBestQuality, sizeof(restartTryBestQuality), checkpointFileHandle);
+	checkpointReadData(&restartLastImprovement, sizeof(restartLastImprovement), checkpointFileHandle);
+}
@@ -0,0 +1,78 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * restart.h
+ *
+ *    This is the header file for restart.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef RESTART_H
+#define RESTART_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <math.h>
+
+#include "solver.h"
+
+
+#define RESTART_NAME_MAXLENGTH 15		/* The maximum length of the restart policy and mode names. */
+
+/* The cutoffs of the restart policies. All factors are
+ * multiplied with the number of variables:
+ * - "luby": RESTART_LUBY_FACTOR multiplied with the Luby
+ *   sequence 1, 1, 2, 1, 1, 2, 4, ...,
+ * - "geometric": RESTART_GEOMETRIC_FACTOR, which grows by
+ *   RESTART_GEOMETRIC_GROWTH with every restart and
+ * - "stagnation": no cutoff, but a restart after
+ *   RESTART_STAGNATION_FACTOR iterations without an
+ *   improvement of the best quality of the try. */
+#define RESTART_LUBY_FACTOR 2
+#define RESTART_GEOMETRIC_FACTOR 2
+#define RESTART_GEOMETRIC_GROWTH 1.5
+#define RESTART_STAGNATION_FACTOR 2
+
+/* The fraction of the variables which are flipped in
+ * the best solution candidate by the restart mode
+ * "perturb". */
+#define RESTART_PERTURBATION 0.05
+
+
+extern char restartPolicyName[RESTART_NAME_MAXLENGTH + 1];
+
+extern bool restartPolicyGiven;
+
+extern char restartModeName[RESTART_NAME_MAXLENGTH + 1];
+
+
+bool restartIsKnownPolicy(char name[]);
+
+bool restartIsKnownMode(char name[]);
+
+unsigned int restartCutoff(unsigned int restartsCount, int ***varList);
+
+bool restartStagnation(unsigned int solverIterations, long long quality, int ***varList);
+
+bool restartGenerate(unsigned int restartsCount, unsigned short **solution, int ***clauseList, int ***varList);
+
+void restartWriteCheckpoint(FILE *checkpointFileHandle);
+
+void restartReadCheckpoint(FILE *checkpointFileHandle);
+
+
+#endif /* RESTART_H */
@@ -37,6 +37,37 @@ unsigned int *tabuList;
 unsigned int *solutionCandidates;
 
 
+/* External variables for the adaptive RoTS:
+ * - rotsAdaptive is true if the adaptive variant is used,
+ * - rotsTenure is the current tabu tenure,
+ * - rotsStagnation is the current stagnation threshold,
+ * - rotsBestQuality is the best quality of the current try
+ *   and
+ * - rotsLastAdaption is the solver iteration of the last
+ *   improvement or stagnation adaption and
+ * - rotsImprovements and rotsStagnations are the numbers of
+ *   the adaptions of the current try (see rotsPrintAdaptions()). */
+bool rotsAdaptive = false;
+double rotsTenure;
+double rotsStagnation;
+long long rotsBestQuality;
+unsigned int rotsLastAdaption;
+unsigned int rotsImprovements;
+unsigned int rotsStagnations;
+
+
+/* External variables for the scan over the variables of
+ * a step (see rotsScan()): the solver iteration, the
+ * quality of the current solution candidate, the
+ * varScoreList, the tabu tenure and the stagnation
+ * threshold. */
+unsigned int rotsScanIteration;
+long long rotsScanQuality;
+int *rotsScanScoreList;
+unsigned int rotsScanTenure;
+unsigned int rotsScanStagnation;
+
+
 /* rotsInitialisation()
  * 
  * Initialisation for the RoTS algorithm. */
@@ -49,6 +80,14 @@ void rotsInitialisation(int ***varList) {
 	solutionCandidates = calloc((*varList)[0][0] + 1, sizeof(int));
 	if (solutionCandidates == NULL)
 		perror("calloc() for solutionCandidates failed");
+
+
+	rotsTenure = ROTS_ADAPTIVE_TENURE_MIN_FACTOR * (*varList)[0][0] + 1;
+	rotsStagnation = ROTS_STAGNATION_FACTOR * (*varList)[0][0];
+	rotsBestQuality = LLONG_MAX;
+	rotsLastAdaption = 0;
+	rotsImprovements = 0;
+	rotsStagnations = 0;
 }
 
 
@@ -56,7 +95,313 @@ void rotsInitialisation(int ***varList) {
  * 
  * Reinitialisation for the RoTS algorithm. */
 void rotsReInitialisation(int ***varList) {
+	rotsPrintAdaptions(); /* The previous try ended. */
+
 	memset(tabuList, 0, ((*varList)[0][0] + 1) * sizeof(unsigned int));
+
+	/* The adaptive tenure and stagnation threshold are kept for the next try. */
+	rotsBestQuality = LLONG_MAX;
+	rotsLastAdaption = 0;
+}
+
+
+/* rotsPrintAdaptions()
+ *
+ * Prints the adaptions of the current try in one "c arots"
+ * line, if there were some, and resets their numbers. */
+void rotsPrintAdaptions() {
+	if (rotsAdaptive == false || (rotsImprovements == 0 && rotsStagnations == 0))
+		return;
+
+	printf("c arots try: %u improvement and %u stagnation adaptions, tabu tenure %u, stagnation threshold %u\n", rotsImprovements, rotsStagnations, (unsigned int)rotsTenure, (unsigned int)rotsStagnation);
+
+	rotsImprovements = 0;
+	rotsStagnations = 0;
+}
+
+
+/* rotsAdapt()
+ *
+ * Adapts the tabu tenure and the stagnation threshold of
+ * the adaptive RoTS after an improvement or a stagnation
+ * (see rots.h) and counts the adaption. */
+void rotsAdapt(bool stagnation, int ***varList) {
+	double tenureMin = ROTS_ADAPTIVE_TENURE_MIN_FACTOR * (*varList)[0][0] + 1;			/* The minimum tabu tenure. */
+	double tenureMax = ROTS_ADAPTIVE_TENURE_MAX_FACTOR * (*varList)[0][0] + 1;			/* The maximum tabu tenure. */
+	double stagnationMin = ROTS_ADAPTIVE_STAGNATION_MIN_FACTOR * (*varList)[0][0];	/* The minimum stagnation threshold. */
+	double stagnationMax = ROTS_STAGNATION_FACTOR * (*varList)[0][0];				/* The maximum stagnation threshold. */
+
+
+	if (stagnation == true) {	/* More diversification */
+		rotsTenure = rotsTenure + ((tenureMax - rotsTenure) * ROTS_ADAPTIVE_PHI);
+		rotsStagnation = rotsStagnation - ((rotsStagnation - stagnationMin) * ROTS_ADAPTIVE_PHI);
+
+		rotsStagnations = rotsStagnations + 1;
+	} else {					/* More intensification */
+		rotsTenure = rotsTenure - ((rotsTenure - tenureMin) * ROTS_ADAPTIVE_PHI / 2.0);
+		rotsStagnation = rotsStagnation + ((stagnationMax - rotsStagnation) * ROTS_ADAPTIVE_PHI / 2.0);
+
+		rotsImprovements = rotsImprovements + 1;
+	}
+}
+
+
+/* rotsScanChunk()
+ *
+ * Scans the variables first to last for the RoTS step:
+ * parallelChunkVariable[chunk] is the first stagnating
+ * variable (0 if there is none), otherwise the non-tabu
+ * variables with the best quality (which doesn't exceed
+ * the current quality) are stored in solutionCandidates
+ * from the index first on, their number in
+ * parallelChunkCount[chunk] and their quality in
+ * parallelChunkValue[chunk]. */
+void rotsScanChunk(unsigned int chunk, unsigned int first, unsigned int last) {
+	unsigned int iVarList;						/* Loop variable for the varList */
+	unsigned int numCandidates = 0;				/* Number of solution candidates of this chunk */
+	long long quality;							/* The quality of an possible solution candidate */
+	long long highestQuality = rotsScanQuality;	/* The highest quality of possible solution candidates */
+
+
+	parallelChunkVariable[chunk] = 0;
+
+	for (iVarList = first; iVarList <= last; iVarList++) {	/* Loop over every variable */
+		if (fixedVariables[iVarList] != 0)
+			continue; /* This variable is fixed and can't be flipped. */
+
+		if (weightedScoreList != NULL)
+			quality = rotsScanQuality - weightedScoreList[iVarList];
+		else
+			quality = rotsScanQuality - rotsScanScoreList[iVarList];
+
+		if (tabuList[iVarList] < (rotsScanIteration - rotsScanStagnation) && (rotsScanIteration > rotsScanStagnation)) { /* Stagnation detected */
+			parallelChunkVariable[chunk] = iVarList;
+			break;
+		}
+
+		if (tabuList[iVarList] < (rotsScanIteration - tabuList[0])) {
+			if (quality < highestQuality) {
+				numCandidates = 1;
+				solutionCandidates[first] = iVarList;
+
+				highestQuality = quality;
+			} else if(quality == highestQuality) {
+				solutionCandidates[first + numCandidates] = iVarList;
+				numCandidates++;
+			}
+		}
+	}
+
+	parallelChunkCount[chunk] = numCandidates;
+	parallelChunkValue[chunk] = highestQuality;
+}
+
+
+/* rotsAdaptiveScanChunk()
+ *
+ * The adaptive variant of rotsScanChunk(). Tabu variables
+ * are only candidates if they improve the best quality of
+ * the current try. */
+void rotsAdaptiveScanChunk(unsigned int chunk, unsigned int first, unsigned int last) {
+	unsigned int iVarList;				/* Loop variable for the varList */
+	unsigned int numCandidates = 0;		/* Number of solution candidates of this chunk */
+	long long quality;					/* The quality of an possible solution candidate */
+	long long highestQuality = 0;		/* The highest quality of possible solution candidates */
+
+
+	parallelChunkVariable[chunk] = 0;
+
+	for (iVarList = first; iVarList <= last; iVarList++) {	/* Loop over every variable */
+		if (fixedVariables[iVarList] != 0)
+			continue; /* This variable is fixed and can't be flipped. */
+
+		if ((rotsScanIteration + 1 - tabuList[iVarList]) > rotsScanStagnation) { /* Stagnation detected */
+			parallelChunkVariable[chunk] = iVarList;
+			break;
+		}
+
+		if (weightedScoreList != NULL)
+			quality = rotsScanQuality - weightedScoreList[iVarList];
+		else
+			quality = rotsScanQuality - rotsScanScoreList[iVarList];
+
+		if (tabuList[iVarList] != 0 && (tabuList[iVarList] + rotsScanTenure) > (rotsScanIteration + 1) && quality >= rotsBestQuality)
+			continue; /* This variable is tabu */
+
+		if (numCandidates == 0 || quality < highestQuality) {
+			numCandidates = 1;
+			solutionCandidates[first] = iVarList;
+
+			highestQuality = quality;
+		} else if(quality == highestQuality) {
+			solutionCandidates[first + numCandidates] = iVarList;
+			numCandidates++;
+		}
+	}
+
+	parallelChunkCount[chunk] = numCandidates;
+	parallelChunkValue[chunk] = highestQuality;
+}
+
+
+/* rotsScan()
+ *
+ * Runs the scanChunk function over all variables, for
+ * large formulas in chunks on the thread pool. Returns
+ * the first stagnating variable or 0, then the solution
+ * candidates of all chunks with the best quality are
+ * moved together in the order of the variables, so the
+ * selection is the same as with a single scan. */
+unsigned int rotsScan(void (*scanChunk)(unsigned int chunk, unsigned int first, unsigned int last), unsigned int numVars) {
+	unsigned int numChunks = parallelChunks(numVars);	/* Number of chunks. */
+	unsigned int iChunks;								/* Loop variable for the chunks. */
+	long long highestQuality = LLONG_MAX;				/* The highest quality of all chunks. */
+
+
+	if (numChunks > 1)
+		parallelRun(scanChunk, numVars, numChunks);
+	else
+		scanChunk(0, 1, numVars);
+
+	for (iChunks = 0; iChunks < numChunks; iChunks++) {
+		if (parallelChunkVariable[iChunks] != 0)
+			return parallelChunkVariable[iChunks];
+
+		if (parallelChunkCount[iChunks] > 0 && parallelChunkValue[iChunks] < highestQuality)
+			highestQuality = parallelChunkValue[iChunks];
+	}
+
+	solutionCandidates[0] = 0;
+
+	for (iChunks = 0; iChunks < numChunks; iChunks++) {
+		if (parallelChunkCount[iChunks] == 0 || parallelChunkValue[iChunks] != highestQuality)
+			continue;
+
+		memmove(&solutionCandidates[solutionCandidates[0] + 1], &solutionCandidates[parallelChunkFirst(iChunks, numVars, numChunks)], parallelChunkCount[iChunks] * sizeof(unsigned int));
+		solutionCandidates[0] = solutionCandidates[0] + parallelChunkCount[iChunks];
+	}
+
+	return 0;
+}
+
+
+/* rotsAdaptiveUpdate()
+ *
+ * Notes the quality of the current solution candidate at
+ * the begin of a step of the adaptive RoTS and adapts the
+ * tabu tenure and the stagnation threshold after an
+ * improvement or a stagnation. */
+void rotsAdaptiveUpdate(long long currentQuality, unsigned int solverIteration, int ***varList) {
+	if (currentQuality < rotsBestQuality) {
+		if (rotsBestQuality != LLONG_MAX)
+			rotsAdapt(false, &(*varList));
+
+		rotsBestQuality = currentQuality;
+		rotsLastAdaption = solverIteration;
+	} else if ((solverIteration - rotsLastAdaption) > (ROTS_ADAPTIVE_THETA * (*varList)[0][0])) {
+		rotsAdapt(true, &(*varList));
+
+		rotsLastAdaption = solverIteration;
+	}
+}
+
+
+/* rotsNoteFlippedVariables()
+ *
+ * Records a step which was not selected by RoTS (the
+ * multi-flip steps) before it is applied: its variables
+ * become tabu like the ones of a RoTS step and the
+ * adaptive RoTS notes the quality of the step. */
+void rotsNoteFlippedVariables(int **flippedVariables, unsigned int solverIteration, int ***varList, int **clauseStatusList) {
+	unsigned int iFlippedVariables;	/* Loop variable for the flippedVariables. */
+
+
+	if (rotsAdaptive == true)
+		rotsAdaptiveUpdate((weightedScoreList != NULL ? weightedScoreList[0] : (*clauseStatusList)[0]), solverIteration, &(*varList));
+
+	for (iFlippedVariables = 1; iFlippedVariables <= (*flippedVariables)[0]; iFlippedVariables++)
+		tabuList[(*flippedVariables)[iFlippedVariables]] = (rotsAdaptive == true ? solverIteration + 1 : solverIteration);
+}
+
+
+/* rotsAdaptiveGetFlippedVariables()
+ * 
+ * The adaptive variant of rotsGetFlippedVariables(). Every
+ * flip is recorded in the tabuList (as solver iteration
+ * + 1, 0 is never flipped). A tabu variable is only
+ * selected, if it improves the best quality of the current
+ * try (aspiration criterion). */
+short rotsAdaptiveGetFlippedVariables(int **flippedVariables, unsigned int solverIteration, unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList) {
+	long long quality;			/* The current quality of and possible solution candidate */
+	long long currentQuality;	/* The quality of the current solution candidate */
+	long long highestQuality;	/* The highest quality of possible solution candidates */
+	unsigned int tenure;		/* The current tabu tenure */
+	unsigned int stagnation;	/* The current stagnation threshold */
+
+	int flippedVariable; 	/* The selected variable to flip */
+
+
+	(*flippedVariables)[0] = 0;
+
+	currentQuality = (weightedScoreList != NULL ? weightedScoreList[0] : (*clauseStatusList)[0]);
+
+
+	rotsAdaptiveUpdate(currentQuality, solverIteration, &(*varList));
+
+	tenure = (unsigned int)rotsTenure;
+	stagnation = (unsigned int)rotsStagnation;
+
+	highestQuality = currentQuality;
+
+
+	/* Aspiration criterion */
+	flippedVariable = rand() % ((*varList)[0][0]) + 1;
+
+	quality = (weightedScoreList != NULL ? (currentQuality - weightedScoreList[flippedVariable]) : (currentQuality - (*varScoreList)[flippedVariable]));
+
+	if (fixedVariables[flippedVariable] == 0 && quality < highestQuality) {
+		tabuList[flippedVariable] = solverIteration + 1;
+
+		(*flippedVariables)[0] = 1;
+		(*flippedVariables)[1] = flippedVariable;
+		TRACE_REASON(1, TRACE_REASON_ASPIRATION);
+		
+		return 1;
+	}
+		
+	
+	rotsScanIteration = solverIteration;
+	rotsScanQuality = currentQuality;
+	rotsScanScoreList = *varScoreList;
+	rotsScanTenure = tenure;
+	rotsScanStagnation = stagnation;
+
+	flippedVariable = rotsScan(rotsAdaptiveScanChunk, (*varList)[0][0]);
+
+	if (flippedVariable != 0) { /* Stagnation detected */
+		tabuList[flippedVariable] = solverIteration + 1;
+
+		(*flippedVariables)[0] = 1;
+		(*flippedVariables)[1] = flippedVariable;
+		TRACE_REASON(1, TRACE_REASON_STAGNATION);
+
+		return 1;
+	}
+
+
+	if (solutionCandidates[0] >= 1) { /* Select a solution candidate uniformly */
+		flippedVariable = solutionCandidates[((rand() % solutionCandidates[0]) + 1)];
+
+		tabuList[flippedVariable] = solverIteration + 1;
+		
+		(*flippedVariables)[0] = 1;
+		(*flippedVariables)[1] = flippedVariable;
+		TRACE_REASON(1, TRACE_REASON_BEST);
+
+		return 1;
+	}
+
+	return 0;
 }
 
 
@@ -71,13 +416,16 @@ void rotsReInitialisation(int ***varList) {
  * - "1" when at least one variable was flipped or
  * - "0" no variables were flipped. */
 short rotsGetFlippedVariables(int **flippedVariables, unsigned int solverIteration, unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList) {
-	unsigned int iVarList;	/* Loop variable for the varList */
-	int quality;			/* The current quality of and possible solution candidate */
-	int highestQuality;		/* The highest quality of possible solution candidates */
+	long long quality;		/* The current quality of and possible solution candidate */
+	long long highestQuality;	/* The highest quality of possible solution candidates (the weight of the unsatisfied clauses in the weighted mode) */
 
 	int flippedVariable; 	/* The selected variable to flip */
 		
 	
+	if (rotsAdaptive == true)
+		return rotsAdaptiveGetFlippedVariables(&(*flippedVariables), solverIteration, &(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList));
+
+
 	if (solverIteration % (*varList)[0][0] == 0)
 		tabuList[0] = (((int)((3 * (*varList)[0][0])/2) + 1) - (int)(((*varList)[0][0])/2)) + (int)(((*varList)[0][0])/2);	/* Reset the tabu tenure */
 
@@ -85,47 +433,38 @@ short rotsGetFlippedVariables(int **flippedVariables, unsigned int solverIterati
 	(*flippedVariables)[0] = 0;
 	
 
-	highestQuality = (*clauseStatusList)[0];
+	highestQuality = (weightedScoreList != NULL ? weightedScoreList[0] : (*clauseStatusList)[0]);
 
 
 	/* Aspiration criterion */
 	flippedVariable = rand() % ((*varList)[0][0]) + 1;
 	
-	if (((*clauseStatusList)[0] - (*varScoreList)[flippedVariable]) < highestQuality) {
+	quality = (weightedScoreList != NULL ? (highestQuality - weightedScoreList[flippedVariable]) : (highestQuality - (*varScoreList)[flippedVariable]));
+
+	if (fixedVariables[flippedVariable] == 0 && quality < highestQuality) {
 		(*flippedVariables)[0] = 1;
 		(*flippedVariables)[1] = flippedVariable;
+		TRACE_REASON(1, TRACE_REASON_ASPIRATION);
 		
 		return 1;
 	}
 		
 	
-	solutionCandidates[0] = 0;
-
-	for (iVarList = 1; iVarList <= (*varList)[0][0]; iVarList++) {	/* Loop over every variable */
-		quality = (*clauseStatusList)[0] - (*varScoreList)[iVarList];
+	rotsScanIteration = solverIteration;
+	rotsScanQuality = highestQuality;
+	rotsScanScoreList = *varScoreList;
+	rotsScanStagnation = ROTS_STAGNATION_FACTOR * (*varList)[0][0];
 
-		if (tabuList[iVarList] < (solverIteration - (ROTS_STAGNATION_FACTOR * (*varList)[0][0]))
-			&& (solverIteration > (ROTS_STAGNATION_FACTOR * (*varList)[0][0]))) { /* Stagnation detected */
-			tabuList[iVarList] = solverIteration;
-			
-			(*flippedVariables)[0] = 1;
-			(*flippedVariables)[1] = iVarList;
-			
-			return 1;
-		}	
+	flippedVariable = rotsScan(rotsScanChunk, (*varList)[0][0]);
 
-		if (tabuList[iVarList] < (solverIteration - tabuList[0])) {
-			if (quality < highestQuality) {
-				solutionCandidates[0] = 1;
-				solutionCandidates[1] = iVarList;
-				
-				highestQuality = quality;
-			} else if(quality == highestQuality) {
-				solutionCandidates[0] = solutionCandidates[0] + 1;
-				solutionCandidates[solutionCandidates[0]] = iVarList;
-			}
-		}
+	if (flippedVariable != 0) { /* Stagnation detected */
+		tabuList[flippedVariable] = solverIteration;
+		
+		(*flippedVariables)[0] = 1;
+		(*flippedVariables)[1] = flippedVariable;
+		TRACE_REASON(1, TRACE_REASON_STAGNATION);
 		
+		return 1;
 	}
 
 
@@ -134,6 +473,7 @@ short rotsGetFlippedVariables(int **flippedVariables, unsigned int solverIterati
 		
 		(*flippedVariables)[0] = (*flippedVariables)[0] + 1;
 		(*flippedVariables)[(*flippedVariables)[0]] = flippedVariable;
+		TRACE_REASON((*flippedVariables)[0], TRACE_REASON_BEST);
 
 		return 1;
 	}
@@ -150,6 +490,34 @@ short rotsGetFlippedVariables(int **flippedVariables, unsigned int solverIterati
  * Deallocate memory which was used by the RoTS
  * algorithm. */
 void rotsCleanUp() {
+	rotsPrintAdaptions(); /* The last try ended. */
+
 	free(tabuList);
 	free(solutionCandidates);
 }
+
+
+/* rotsWriteCheckpoint()
+ *
+ * Writes the state of the RoTS algorithm into the
+ * checkpoint file. */
+void rotsWriteCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointWriteData(tabuList, ((*varList)[0][0] + 1) * sizeof(unsigned int), checkpointFileHandle);
+	checkpointWriteData(&rotsTenure, sizeof(rotsTenure), checkpointFileHandle);
+	checkpointWriteData(&rotsStagnation, sizeof(rotsStagnation), checkpointFileHandle);
+	checkpointWriteData(&rotsBestQuality, sizeof(rotsBestQuality), checkpointFileHandle);
+	checkpointWriteData(&rotsLastAdaption, sizeof(rotsLastAdaption), checkpointFileHandle);
+}
+
+
+/* rotsReadCheckpoint()
+ *
+ * Reads the state of the RoTS algorithm from the
+ * checkpoint file. */
+void rotsReadCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointReadData(tabuList, ((*varList)[0][0] + 1) * sizeof(unsigned int), checkpointFileHandle);
+	checkpointReadData(&rotsTenure, sizeof(rotsTenure), checkpointFileHandle);
+	checkpointReadData(&rotsStagnation, sizeof(rotsStagnation), checkpointFileHandle);
+	checkpointReadData(&rotsBestQuality, sizeof(rotsBestQuality), checkpointFileHandle);
+	checkpointReadData(&rotsLastAdaption, sizeof(rotsLastAdaption), checkpointFileHandle);
+}
@@ -37,12 +37,43 @@
 #define ROTS_STAGNATION_FACTOR 5	
 
 
+/* Adaptive RoTS ("arots")
+ *
+ * The tabu tenure and the stagnation threshold are adapted
+ * like the adaptive noise mechanism of Hoos: If the best
+ * quality of the current try wasn't improved for
+ * ROTS_ADAPTIVE_THETA multiplied with the number of
+ * variables iterations, the search stagnates. Then the
+ * tenure is increased and the stagnation threshold is
+ * decreased by the fraction ROTS_ADAPTIVE_PHI of the
+ * distance to their limits. Each improvement changes both
+ * by the half of this fraction in the opposite direction.
+ * The limits are factors multiplied with the number of
+ * variables. */
+#define ROTS_ADAPTIVE_THETA 0.5
+#define ROTS_ADAPTIVE_PHI 0.2
+#define ROTS_ADAPTIVE_TENURE_MIN_FACTOR 0.01
+#define ROTS_ADAPTIVE_TENURE_MAX_FACTOR 0.2
+#define ROTS_ADAPTIVE_STAGNATION_MIN_FACTOR 1
+
+
+extern bool rotsAdaptive;
+
+
 void rotsInitialisation(int ***varList);
 
 void rotsReInitialisation(int ***varList);
 
+void rotsPrintAdaptions();
+
+void rotsNoteFlippedVariables(int **flippedVariables, unsigned int solverIteration, int ***varList, int **clauseStatusList);
+
 short rotsGetFlippedVariables(int **flippedVariables, unsigned int solverIteration, unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList);
 
+void rotsWriteCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
+void rotsReadCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
 void rotsCleanUp();
 
 
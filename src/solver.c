@@ -22,6 +22,31 @@
 #include "solver.h"
 
 
+/* External variable for the fixed variables.
+ * It contains for each variable 0 if the variable
+ * can be flipped by the solving algorithm or the
+ * fixed value + 1 (see fixVariable()).
+ * The index 0 (fixedVariables[0]) is the number of
+ * fixed variables. */
+unsigned short *fixedVariables = NULL;
+
+
+/* External variable for the number of restarts of the
+ * last search (see solverSearch()). */
+unsigned int solverRestarts = 0;
+
+
+/* External variable for the number of flipped variables of
+ * the last search (see solverSearch()). */
+unsigned long long solverFlips = 0;
+
+
+/* External variable for the number of variables of the
+ * formula. The index 0 of the solution only holds it up to
+ * 65535 variables. */
+unsigned int solverNumVars = 0;
+
+
 /* updateVarScoreList()
  *
  * Updating the varScoreList based on the current solution
@@ -34,6 +59,15 @@ void updateVarScoreList(unsigned short **solution, int ***varList, int **varScor
 	int curClause; 					/* Current selected clause in the iVarListClause loop. */
 
 
+	if (parallelRebuildVarScoreList(&(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList)) == true)
+		return; /* The thread pool determined the scores variable by variable. */
+
+	if (ksatLength != 0) {	/* The k-SAT kernels determine the scores clause by clause. */
+		ksatRebuildVarScoreList(&(*solution), &(*varList), &(*clauseStatusList));
+		return;
+	}
+
+
 	memset((*varScoreList), 0, sizeof(int) * ((*varList)[0][0] + 1));
 
 
@@ -71,6 +105,20 @@ void updateClauseStatusList(int **flippedVariables, unsigned short **solution, i
 	int curClause; 						/* Current selected clause in the iVarClauseList loop. */
 
 
+	if (clauseWeightList != NULL) {	/* The weighted mode updates the weighted scores, too. */
+		weightedUpdateClauseStatusList(&(*flippedVariables), &(*solution), &(*varList), &(*clauseStatusList));
+		return;
+	}
+
+	if (multiflipIndependent == true && multiflipUpdateClauseStatusList(&(*flippedVariables), &(*solution), &(*varList), &(*clauseStatusList)) == true)
+		return; /* The thread pool updated the independent variables of a multi-flip step. */
+
+	if (ksatLength != 0) {			/* The k-SAT kernels update the scores, too. */
+		ksatUpdateClauseStatusList(&(*flippedVariables), &(*solution), &(*varList), &(*clauseStatusList));
+		return;
+	}
+
+
 	unsatisfiedClauses = (*clauseStatusList)[0];
 
 	for (iFlippedVariables = 1; iFlippedVariables <= (*flippedVariables)[0]; iFlippedVariables++) {								/* Loop over every flipped variable. */
@@ -102,21 +150,250 @@ void updateClauseStatusList(int **flippedVariables, unsigned short **solution, i
 }
 
 
+/* listCapacity()
+ *
+ * Returns the number of allocated elements of a list which
+ * holds the given number of elements. All lists which can
+ * grow by addVariables() or addClause() are allocated in
+ * powers of two, so the capacity is given by the size and
+ * doesn't have to be stored beside the list. */
+unsigned int listCapacity(unsigned int size) {
+	unsigned int capacity = S_LIST_CAPACITY_MIN;
+
+	while (capacity < size)
+		capacity = capacity * 2;
+
+	return capacity;
+}
+
+
+/* growList()
+ *
+ * Grows a list from the old size to the new size (both
+ * including the index 0) and returns the (maybe moved) list.
+ * The list is only reallocated if the capacity of the old
+ * size is exceeded. New elements are initialised with 0. */
+void *growList(void *list, unsigned int oldSize, unsigned int newSize, size_t elementSize) {
+	unsigned int oldCapacity = (list == NULL ? 0 : listCapacity(oldSize));	/* Capacity of the list before growing. */
+	unsigned int newCapacity;												/* Capacity of the list after growing. */
+
+
+	if (newSize > oldCapacity) {
+		newCapacity = listCapacity(newSize);
+
+		list = realloc(list, newCapacity * elementSize);
+		if (list == NULL)
+			perror("realloc() for growing list failed");
+
+		memset((char *)list + (oldCapacity * elementSize), 0, (newCapacity - oldCapacity) * elementSize);
+	}
+
+	if (newSize > oldSize && oldCapacity > oldSize)
+		memset((char *)list + (oldSize * elementSize), 0, ((newSize < oldCapacity ? newSize : oldCapacity) - oldSize) * elementSize);
+
+	return list;
+}
+
+
+/* initialiseFormula()
+ *
+ * Allocates an empty formula without variables and clauses.
+ * The formula can be extended by addVariables() and
+ * addClause(). */
+void initialiseFormula(int ***clauseList, int ***varList, int **varScoreList, unsigned short **solution, int **clauseStatusList, int **flippedVariables) {
+	*clauseList = growList(NULL, 0, 1, sizeof(int *));
+	(*clauseList)[0] = calloc(1, sizeof(int)); /* Only the index 0 for the number of clauses. */
+	if ((*clauseList)[0] == NULL)
+		perror("calloc() for clauseList[0] failed");
+
+	*varList = growList(NULL, 0, 1, sizeof(int *));
+	(*varList)[0] = calloc(1, sizeof(int)); /* Only the index 0 for the number of variables. */
+	if ((*varList)[0] == NULL)
+		perror("calloc() for varList[0] failed");
+
+	*varScoreList = growList(NULL, 0, 1, sizeof(int));
+	*solution = growList(NULL, 0, 1, sizeof(unsigned short));
+	*clauseStatusList = growList(NULL, 0, 1, sizeof(int));
+	*flippedVariables = growList(NULL, 0, 1, sizeof(int));
+
+	free(fixedVariables);
+	fixedVariables = growList(NULL, 0, 1, sizeof(unsigned short));
+}
+
+
+/* addVariables()
+ *
+ * Extends the formula to the given number of variables. New
+ * variables have no occurrences, are not fixed and are
+ * assigned to false. Nothing is done if the formula has
+ * already that many variables. */
+void addVariables(unsigned int numVars, int ***varList, int **varScoreList, unsigned short **solution, int **flippedVariables) {
+	unsigned int oldNumVars = (*varList)[0][0];	/* Number of variables before extending the formula. */
+	unsigned int iVarList;						/* Loop variable for the new variables in the varList. */
+
+
+	if (numVars <= oldNumVars)
+		return;
+
+	*varList = growList(*varList, (oldNumVars + 1), (numVars + 1), sizeof(int *));
+
+	for (iVarList = (oldNumVars + 1); iVarList <= numVars; iVarList++) {
+		(*varList)[iVarList] = calloc(listCapacity(1), sizeof(int)); /* Occurrences are appended by addClause(). */
+		if ((*varList)[iVarList] == NULL)
+			perror("calloc() for varList collums failed");
+	}
+
+	(*varList)[0][0] = numVars;
+
+	*varScoreList = growList(*varScoreList, (oldNumVars + 1), (numVars + 1), sizeof(int));
+	*solution = growList(*solution, (oldNumVars + 1), (numVars + 1), sizeof(unsigned short));
+	*flippedVariables = growList(*flippedVariables, (oldNumVars + 1), (numVars + 1), sizeof(int));
+	fixedVariables = growList(fixedVariables, (oldNumVars + 1), (numVars + 1), sizeof(unsigned short));
+
+	(*solution)[0] = numVars;
+	solverNumVars = numVars;
+}
+
+
+/* addClause()
+ *
+ * Appends a clause to the formula. The index 0 of literals
+ * contains the number of literals; all variables have to
+ * exist (see addVariables()). The occurrence lists in the
+ * varList are grown in place and the clauseStatusList is
+ * updated for the current solution candidate, so a running
+ * search can continue with the extended formula.
+ * The function returns the number of the new clause. */
+int addClause(int literals[], int ***clauseList, int ***varList, unsigned short **solution, int **clauseStatusList) {
+	unsigned int numClauses = (*clauseList)[0][0] + 1;	/* Number of clauses with the new clause. */
+	unsigned int iLiterals;								/* Loop variable for literals. */
+	int var;											/* Variable of the current literal. */
+	int occurrences;									/* Number of occurrences of this variable. */
+
+
+	*clauseList = growList(*clauseList, numClauses, (numClauses + 1), sizeof(int *));
+
+	(*clauseList)[numClauses] = malloc((literals[0] + 1) * sizeof(int)); /* +1 for index 0 for the number of literals in this clause. */
+	if ((*clauseList)[numClauses] == NULL)
+		perror("malloc() for clauseList collums failed");
+
+	memcpy((*clauseList)[numClauses], literals, (literals[0] + 1) * sizeof(int));
+
+	(*clauseList)[0][0] = numClauses;
+
+
+	*clauseStatusList = growList(*clauseStatusList, numClauses, (numClauses + 1), sizeof(int));
+
+	for (iLiterals = 1; iLiterals <= literals[0]; iLiterals++) {
+		var = (literals[iLiterals] > 0 ? literals[iLiterals] : (literals[iLiterals] * -1));
+
+		if ((literals[iLiterals] > 0 && (*solution)[var] == 1) || (literals[iLiterals] < 0 && (*solution)[var] == 0))
+			(*clauseStatusList)[numClauses] = (*clauseStatusList)[numClauses] + 1;
+
+		occurrences = (*varList)[var][0] + 1;
+		(*varList)[var] = growList((*varList)[var], occurrences, (occurrences + 1), sizeof(int));
+		(*varList)[var][occurrences] = (literals[iLiterals] > 0 ? (int)numClauses : ((int)numClauses * -1));
+		(*varList)[var][0] = occurrences;
+	}
+
+	if ((*clauseStatusList)[numClauses] == 0)
+		(*clauseStatusList)[0] = (*clauseStatusList)[0] + 1;
+
+	return numClauses;
+}
+
+
+/* fixVariable()
+ *
+ * Fixes the variable of the literal to the value which
+ * satisfies the literal, so it can't be flipped by the
+ * solving algorithm anymore. The solution candidate and the
+ * clauseStatusList are updated if the variable has to be
+ * flipped. */
+void fixVariable(int literal, int ***varList, unsigned short **solution, int **clauseStatusList, int **flippedVariables) {
+	unsigned int var = (literal > 0 ? literal : (literal * -1));	/* Variable of the literal. */
+	unsigned short value = (literal > 0 ? 1 : 0);					/* Value which satisfies the literal. */
+
+
+	if (fixedVariables[var] == 0)
+		fixedVariables[0] = fixedVariables[0] + 1;
+
+	fixedVariables[var] = value + 1;
+
+	if ((*solution)[var] != value) {
+		(*solution)[var] = value;
+
+		(*flippedVariables)[0] = 1;
+		(*flippedVariables)[1] = var;
+
+		updateClauseStatusList(&(*flippedVariables), &(*solution), &(*varList), &(*clauseStatusList));
+	}
+}
+
+
+/* releaseVariables()
+ *
+ * Releases all fixed variables (see fixVariable()). */
+void releaseVariables(int ***varList) {
+	memset(fixedVariables, 0, ((*varList)[0][0] + 1) * sizeof(unsigned short));
+}
+
+
+/* normaliseClause()
+ *
+ * Removes duplicated literals from the clause. The index 0
+ * of literals contains the number of literals. It returns
+ * false if the clause contains a literal and its negation
+ * and is always satisfied. */
+bool normaliseClause(int literals[]) {
+	unsigned int iLiterals;		/* Loop variable for literals. */
+	unsigned int jLiterals;		/* Loop variable for the already kept literals. */
+	unsigned int numLiterals = 0;	/* Number of kept literals. */
+	bool isDuplicate;			/* Is the current literal already kept? */
+
+
+	for (iLiterals = 1; iLiterals <= literals[0]; iLiterals++) {
+		isDuplicate = false;
+
+		for (jLiterals = 1; jLiterals <= numLiterals; jLiterals++) {
+			if (literals[jLiterals] == (literals[iLiterals] * -1))
+				return false;
+
+			if (literals[jLiterals] == literals[iLiterals])
+				isDuplicate = true;
+		}
+
+		if (isDuplicate == false) {
+			numLiterals++;
+			literals[numLiterals] = literals[iLiterals];
+		}
+	}
+
+	literals[0] = numLiterals;
+
+	return true;
+}
+
+
 /* readInstanceFile()
  *
  * This function analyses the instance file according to the
  * DIMACS rules given in 4.1 from
  * http://www.satcompetition.org/2011/rules.pdf. It tries to
  * catch all possible violations of the DIMACS rules. But when
- * the file doesn't fit the rules, the program maybe crash. */
+ * the file doesn't fit the rules, the program maybe crash.
+ * A "p wcnf <nbvar> <nbclauses> <top>" line switches to the
+ * weighted mode (see weighted.c), then every clause line
+ * starts with the weight of the clause.
+ * Duplicated literals are removed and clauses which are
+ * always satisfied are skipped. */
 void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList, int **varScoreList, unsigned short **solution, int **clauseStatusList, int **flippedVariables) {
 	FILE *instanceFileHandle;									/* File hande for the instance file. */
 	char instanceFileLineBuf[S_INSTANCEFILE_LINE_MAXLENGTH]; 	/* Buffer for a line of the instance file. */
+	int literalsBuf[S_INSTANCEFILE_LINE_MAXLENGTH + 1];			/* Buffer for the literals of a clause line (index 0 for the number of literals). */
 	
 	unsigned int numClauses = 0;	/* Number of clauses in the instance file. */
 	unsigned int numVars = 0;		/* Number of variables in the instance file. */
-	unsigned int ii; 				/* Loop variable for the clauseList initialisation. */
-	unsigned int jj; 				/* Loop variable for the varList initialisation. */
 	bool pLineAnalysed = false;		/* Is the "p cnf <nbvar> <nbclauses>" line already founded and analysed? */
 
 	unsigned int analysedClauses = 0;		/* Number of founded and analysed clauses lines in the instance file. (0 is for total number of clauses) */
@@ -124,8 +401,12 @@ void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList
 	unsigned int kk; 						/* Loop variable for the clause line analysis. */
 	char *pEnd; 							/* Pointer needed for the strtol() function in the clause analysis loop. */
 	int litTmp; 							/* Temporal variable for one literal in the clause analysis loop. */
+	long long weightTmp = 0;				/* The weight of the clause line in the weighted mode. */
+	long long top = LLONG_MAX;				/* The weight of the hard clauses given in the "p wcnf" line. */
 
 
+	weightedMode = false;
+
 	instanceFileHandle = fopen(instanceFilePath, "r");
 
 	if (instanceFileHandle == NULL) {
@@ -134,56 +415,17 @@ void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList
 		while (fgets(instanceFileLineBuf, S_INSTANCEFILE_LINE_MAXLENGTH, instanceFileHandle) != NULL) {
 			if (instanceFileLineBuf[0] == 'p') { 		/* This is the "p cnf <nbvar> <nbclauses>" line. */
 				if (pLineAnalysed == false) {
-					sscanf(instanceFileLineBuf, "p cnf %d %d", &numVars, &numClauses);
-					
-					/* Initialise clauseList, variableList, varScoreList, solution, clauseStatusList and flippedVariables. */
-					*clauseList = malloc((numClauses + 1) * sizeof(int *)); /* +1 for index 0 for the number of clauses. */
-					if (*clauseList == NULL)
-						perror("malloc() for clauseList rows failed");
-					
-					for(ii = 0; ii <= numClauses; ii++) { 	/* <= for the additional row! */
-						(*clauseList)[ii] = calloc((numVars + 1), sizeof(int));	/* +1 for index 0 for the number of literals in this clause. */
-						if ((*clauseList)[ii] == NULL)
-							perror("calloc() for clauseList collums failed");
-					}
-					
-					(*clauseList)[0][0] = numClauses;
-					
-					
-					*varList = malloc((numVars + 1) * sizeof(int *)); /* +1 for index 0 for the number variables. */
-					if (*varList == NULL)
-						perror("malloc() for varList rows failed");
-					
-					for(jj = 0; jj <= numVars; jj++) { 		/* <= for the additional collum ! */
-						(*varList)[jj] = calloc((numClauses + 1), sizeof(int)); /* +1 for index 0 for the number of clauses which contains this variable. */
-						if ((*varList)[jj] == NULL)
-							perror("calloc() for varList collums failed");
+					if (strncmp(instanceFileLineBuf, "p wcnf", 6) == 0) {
+						weightedMode = true;
+						sscanf(instanceFileLineBuf, "p wcnf %d %d %lld", &numVars, &numClauses, &top);
+					} else {
+						sscanf(instanceFileLineBuf, "p cnf %d %d", &numVars, &numClauses);
 					}
 					
-					(*varList)[0][0] = numVars;
-					
-					
-					*varScoreList = calloc((numVars + 1), sizeof(int)); /* +1 beacuse the variable indices starts at 1 (index 0 unused so far...). */
-					if (*varScoreList == NULL)
-						perror("calloc() for varScoreList rows failed");
-					
-					
-					*solution = calloc((numVars + 1), sizeof(unsigned short)); /* +1 for the quality of the solution at index 0. */
-					if (*solution == NULL)
-						perror("calloc() for solution failed");
-						
-					(*solution)[0] = numVars;
-					
-					
-					*clauseStatusList = calloc((numClauses + 1), sizeof(int)); /* +1 for the index 0 which contains the number of unsatisfied clause. */
-					if (*clauseStatusList == NULL)
-						perror("calloc() for clauseStatusList failed");
-					
-					
-					*flippedVariables = calloc((numVars + 1), sizeof(int)); /* +1 for the number of flipped variables at index 0. */
-					if (*flippedVariables == NULL)
-						perror("calloc() for flippedVariables failed");
-					
+					/* Initialise clauseList, variableList, varScoreList, solution, clauseStatusList and flippedVariables. */
+					initialiseFormula(&(*clauseList), &(*varList), &(*varScoreList), &(*solution), &(*clauseStatusList), &(*flippedVariables));
+
+					addVariables(numVars, &(*varList), &(*varScoreList), &(*solution), &(*flippedVariables));
 					
 					pLineAnalysed = true;
 				} else {
@@ -201,6 +443,13 @@ void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList
 						analysedClauseLit = 0;
 						pEnd = instanceFileLineBuf;
 
+						if (weightedMode == true) {
+							weightTmp = strtoll(pEnd, &pEnd, 10);
+
+							if (weightTmp <= 0)
+								pExit("The clause line %d has no positive weight!\n", (analysedClauses + 1));
+						}
+
 						for (kk = 0; kk < S_INSTANCEFILE_LINE_MAXLENGTH; kk++) { /* Looping over a clause line character by character. */
 							litTmp = (int)strtol(pEnd, &pEnd, 10);
 						
@@ -211,20 +460,20 @@ void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList
 							} else if ((litTmp > 0 && litTmp > numVars) || (litTmp < 0 && (litTmp * -1) > numVars)) {	/* The variable is not in the given range by. */
 								pExit("The variable %d in clause line %d is out of range of %d!\n", litTmp, (analysedClauses + 1), numVars);
 							} else {
-								(*clauseList)[(analysedClauses + 1)][(analysedClauseLit + 1)] = litTmp;
-								if (litTmp > 0) {
-									(*varList)[litTmp][0] = (*varList)[litTmp][0] + 1;
-									(*varList)[litTmp][(*varList)[litTmp][0]] = (analysedClauses + 1);
-								} else {
-									(*varList)[(litTmp * -1)][0] = (*varList)[(litTmp * -1)][0] + 1;
-									(*varList)[(litTmp * -1)][(*varList)[(litTmp * -1)][0]] = (analysedClauses + 1) * -1;
-								}
+								literalsBuf[(analysedClauseLit + 1)] = litTmp;
 							}
 							
 							analysedClauseLit++;
 						}
 						
-						(*clauseList)[(analysedClauses + 1)][0] = analysedClauseLit; /* Number of founded literals in this clause. */
+						literalsBuf[0] = analysedClauseLit; /* Number of founded literals in this clause. */
+
+						if (normaliseClause(literalsBuf) == true) {
+							addClause(literalsBuf, &(*clauseList), &(*varList), &(*solution), &(*clauseStatusList));
+
+							if (weightedMode == true)
+								weightedAddClause(weightTmp, &(*clauseList));
+						}
 					}
 				}
 				
@@ -232,61 +481,79 @@ void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList
 			}
 		} /* End instance file line loop */
 
+		fclose(instanceFileHandle);
+
 		if (analysedClauses < numClauses)
 			pExit("There are not the same number of clauses in the file when specified in the \"p cnf %d %d\" line!\n", numVars, numClauses);
+
+		if (weightedMode == true)
+			weightedInitialisation(top, &(*clauseList), &(*varList));
 	}
 }
 
 
-/* solver()
+/* rebuildClauseStatusList()
  *
- * The is the main solving function. The idea is to
- * encapsulate the functionality, which are used
- * by all alogorithm.
- * The solving process generate an random initial
- * solution candidate. In each solver iteration step
- * a "get flipped variable" function for the specific
- * algorithm is called to retrieve a list of variables
- * to flipp. Then the status of each clause (see
- * clauseList variable description) and the score of
- * each variable (see varScoreList variable description).
- * The function returns the number of the unsatisfied
- * clauses. */
-int solver(unsigned short **solution, char instanceFilePath[], char algoName[]) {
-	/* This list contains all clauses with their literals. If
-	 * the literal has a negation, the variable is represented
-	 * as an negativ integer. The index 0 in the clause
-	 * (clauseList[x][0]) contains the number of literals in
-	 * this clause.
-	 * The index 0 (clauseList[0][0]) contains the total number
-	 * of clauses. */
-	int **clauseList;
- 	
-	/* This list contains all variables mapped to the clause
-	 * number in which they occur (negative then the literal
-	 * has a negation, positive otherwise). The index 0 in the
-	 * variable (varList[x][0]) contains the total number of
-	 * clauses. The index 0 (varList[0][0]) contains the total
-	 * number of variables. */
-	int **varList;
- 
-	/* This list contains the score (the number of clause 
-	 * satisfied [positiv] or unsatisfied [negative], if
-	 * this variable will be flipped in the next iteration step. */
-	int *varScoreList;
+ * Determines the clauseStatusList from scratch for the
+ * solution candidate. This is done after each initial
+ * assignment construction. */
+void rebuildClauseStatusList(unsigned short **solution, int ***clauseList, int **clauseStatusList) {
+	unsigned int iClauseList;		/* Loop variable for clauseList. */
+	unsigned int iClauseListLit;	/* Loop variable for every literal in the clause. */
+	unsigned int unsatisfiedClauses = 0;	/* Number of unsatisfied clauses. */
+	int *clause;					/* Current clause of the loop. */
+	int trueLiterals;				/* Number of true literals in the current clause. */
+	int curLiteral;					/* Current literal of the loop. */
+
+
+	if (parallelRebuildClauseStatusList(&(*solution), &(*clauseList), &(*clauseStatusList)) == true)
+		return;
+
+	if (ksatLength != 0) {
+		ksatRebuildClauseStatusList(&(*solution), &(*clauseStatusList));
+		return;
+	}
 
-	/* For each clause this list holds the number of true
-	 * literals. */
-	int *clauseStatusList;
 
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++) {	/* Loop over every clause. */
+		clause = (*clauseList)[iClauseList];
+		trueLiterals = 0;
+
+		for (iClauseListLit = 1; iClauseListLit <= clause[0]; iClauseListLit++) {	/* Loop over every literal in the clause. */
+			curLiteral = clause[iClauseListLit];
+			trueLiterals = trueLiterals + (curLiteral > 0 ? (*solution)[curLiteral] : (1 - (*solution)[(curLiteral * -1)]));
+		}
+
+		(*clauseStatusList)[iClauseList] = trueLiterals;
+		unsatisfiedClauses = unsatisfiedClauses + (trueLiterals == 0);
+	}
+
+	(*clauseStatusList)[0] = unsatisfiedClauses;
+}
+
+
+/* solverSearch()
+ *
+ * This function runs the restart loop of the solving process
+ * on an already loaded formula (see solver() for the
+ * description of the lists). The length of each try is
+ * given by the restart policy (see restartCutoff()) and
+ * each restart generates a solution candidate with the
+ * restart mode (see restartGenerate()), the fixed
+ * variables (see fixVariable()) keep their value. If warmStart is true, the
+ * first try continues from the current solution candidate and
+ * clauseStatusList instead, so only clauses which are not
+ * satisfied by it have to be repaired.
+ * The function returns the number of the unsatisfied
+ * clauses. */
+int solverSearch(unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, int **clauseStatusList, int **flippedVariables, char algoName[], unsigned int maxRestarts, bool warmStart) {
 	unsigned int restartsCount = 0;		/* Number of restarts. */
 	unsigned int solverIterations = 0;	/* Number of solver iterations. This is reseted after each restart! */
+	unsigned int solverCutoff;			/* Maximum number of solver iterations of the current try. */
 
-	int solutionQuality; 	/* Return value */
-	
-	unsigned int iRandSolAsgmt; 	/* Loop variable for the random solution assignment. */
-	unsigned int iClauseList;		/* Loop variable for clauseList in the random solution assignment. */
-	unsigned int iClauseListLit;	/* Loop variable for every literal in the clauseList in the random solution assignment. */
+	bool stagnationRestarts = (strcmp(restartPolicyName, "stagnation") == 0);	/* Ends a stagnating try? */
+	bool resumed;																/* Does the try resume the current solution candidate? */
+	bool resumeCheckpoint = checkpointResume;									/* Does the search continue from the checkpoint file? */
 		
 	/* The returing value of the getFlippedVariables() function
 	 * of the specific alogrithm. Possible return values:
@@ -295,125 +562,297 @@ int solver(unsigned short **solution, char instanceFilePath[], char algoName[])
 	 * -1 = an restart is needed. */
 	short getFlippedVariablesStatus;	
 	
-	int *flippedVariables;			/* The flipped variables selected by the algorithm. */
 	unsigned int iFlippedVariables;	/* Loop variable for the flippedVariables. */
-	
-	unsigned int clauseListCU; 	/* Number of clauses for the clean-up loop. */
-	unsigned int iclauseListCU; 	/* Loop variable for the clauseList clean up. */
-	unsigned int varListCU; 	/* Number of variables for the clean-up loop. */
-	unsigned int iVarListCU; 	/* Loop variable for the varList clean up. */
-	
-	
-	readInstanceFile(instanceFilePath, &clauseList, &varList, &varScoreList, &(*solution), &clauseStatusList, &flippedVariables);
 
 
-	while(restartsCount < S_RESTARTS_MAX) {										/* Restart loop */
-		solverIterations = 0;
+	solverFlips = 0;
 
-		/* Generate random solution candidate assignment */
-		for (iRandSolAsgmt = 1; iRandSolAsgmt <= varList[0][0]; iRandSolAsgmt++) {
-			(*solution)[iRandSolAsgmt] = rand() % 2;
-		}
+	/* Alogrithm initialisation */
+	rotsAdaptive = (strcmp(algoName, "arots") == 0);
 
-		clauseStatusList[0] = 0;
+	if (strcmp(algoName, "rots") == 0 || rotsAdaptive == true) {			/* Robust Tabu Search (RoTS) */
+		rotsInitialisation(&(*varList));
+	} else if (strcmp(algoName, "ilssa") == 0) {	/* ILS/SA */
+		ilssaInitialisation(&(*varList));
+	} else {
+		pExit("No (re)initialisation function for the solving alogrithm with the name \"%s\" not founded!\n", algoName);
+	}
 
-		for (iClauseList = 1; iClauseList <= clauseList[0][0]; iClauseList++) {							/* Loop over every clause to determine the initialisation of the clauseStatusList with the random solution assignment. */
-			clauseStatusList[iClauseList] = 0;
-			for (iClauseListLit = 1; iClauseListLit <= clauseList[iClauseList][0]; iClauseListLit++) {	/* Loop over every literal in the clause. */
-				if ((clauseList[iClauseList][iClauseListLit] > 0 && (*solution)[clauseList[iClauseList][iClauseListLit]] == 1) ||
-					(clauseList[iClauseList][iClauseListLit] < 0 && (*solution)[(clauseList[iClauseList][iClauseListLit] * -1)] == 0)) { /* The clause is now satisfied by this variable. */
-						clauseStatusList[iClauseList] = clauseStatusList[iClauseList] + 1; 
-				}
+	assignmentInitialisation(&(*varList));
+
+	ksatInitialisation(&(*clauseList), &(*varList), &(*varScoreList));
+
+	multiflipInitialisation(&(*varList));
+
+	traceInitialisation(&(*varList));
+
+	if (resumeCheckpoint == true)
+		checkpointRead(&restartsCount, &solverIterations, &solverCutoff, &(*solution), &(*clauseList), &(*varList), &(*varScoreList), &(*clauseStatusList), algoName);
+
+
+	while(restartsCount < maxRestarts) {										/* Restart loop */
+		if (resumeCheckpoint == true) {
+			resumeCheckpoint = false; /* The try continues from the checkpoint. */
+		} else {
+			PROFILE_START(PROFILE_PHASE_RESTART);
+
+			if (traceReasonList != NULL)
+				traceRestart(restartsCount);
+
+			solverIterations = 0;
+			solverCutoff = restartCutoff(restartsCount, &(*varList));
+
+			resumed = false;
+
+			if (restartsCount > 0 || warmStart == false) {
+				assignmentSyncBest(&(*solution), &(*varList));
+
+				/* Generate the initial solution candidate assignment */
+				if (restartGenerate(restartsCount, &(*solution), &(*clauseList), &(*varList)) == true)
+					rebuildClauseStatusList(&(*solution), &(*clauseList), &(*clauseStatusList));
+				else
+					resumed = true; /* The lists of the last try are still valid. */
 			}
+
+			if (resumed == true && clauseWeightList == NULL && ksatLength == 0)
+				updateVarScoreList(&(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList)); /* The last try may have ended after a flip without a score update (e.g. the ILS/SA perturbation). */
+
+			if (resumed == false) {
+				assignmentUpdateBest(&(*solution), &(*varList), &(*clauseStatusList));
+
+				if (clauseWeightList != NULL) {
+					weightedRebuildScoreList(&(*solution), &(*clauseList), &(*varList), &(*clauseStatusList));
+					weightedUpdateBest(&(*solution), &(*varList));
+				}
+
+				if ((*clauseStatusList)[0] == 0) {
+					PROFILE_STOP(PROFILE_PHASE_RESTART);
+					break; /* Solution founded (e.g. the warm start solution candidate still satisfies all clauses) */
+				}
 			
-			if (clauseStatusList[iClauseList] == 0)
-				clauseStatusList[0] = clauseStatusList[0] + 1;
-		}
-		
-		updateVarScoreList(&(*solution), &varList, &varScoreList, &clauseStatusList);
-
-
-		/* Alogrithm (re)initialisation */
-		if (strcmp(algoName, "rots") == 0) {			/* Robust Tabu Search (RoTS) */
-			if (restartsCount < 1)
-				rotsInitialisation(&varList);
-			else
-				rotsReInitialisation(&varList);
-		} else if (strcmp(algoName, "ilssa") == 0) {	/* ILS/SA */
-			if (restartsCount < 1)
-				ilssaInitialisation(&varList);
-		} else {
-			pExit("No (re)initialisation function for the solving alogrithm with the name \"%s\" not founded!\n", algoName);
+				if (clauseWeightList == NULL)
+					updateVarScoreList(&(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList));
+			}
+
+
+			/* Alogrithm reinitialisation */
+			if (restartsCount > 0 && (strcmp(algoName, "rots") == 0 || rotsAdaptive == true))	/* Robust Tabu Search (RoTS) */
+				rotsReInitialisation(&(*varList));
+
+			PROFILE_STOP(PROFILE_PHASE_RESTART);
 		}
 
-		while(clauseStatusList[0] > 0 && solverIterations < (S_SOLVERITERATIONS_MAXFACTOR * varList[0][0])) { /* The solving process */
-			flippedVariables[0] = 0;
+		while((*clauseStatusList)[0] > 0 && solverIterations < solverCutoff) { /* The solving process */
+			(*flippedVariables)[0] = 0;
+
+			PROFILE_START(PROFILE_PHASE_STEP);
 
-			if (strcmp(algoName, "rots") == 0) {			/* Robust Tabu Search (RoTS) */
-				getFlippedVariablesStatus = rotsGetFlippedVariables(&flippedVariables, solverIterations, &(*solution), &varList, &varScoreList, &clauseStatusList);
+			if (multiflipMax > 0 && multiflipGetFlippedVariables(&(*flippedVariables), &(*clauseList), &(*varList), &(*varScoreList)) == 1) {	/* Independent improving variables */
+				getFlippedVariablesStatus = 1;
+
+				if (strcmp(algoName, "rots") == 0 || rotsAdaptive == true)
+					rotsNoteFlippedVariables(&(*flippedVariables), solverIterations, &(*varList), &(*clauseStatusList));
+			} else if (strcmp(algoName, "rots") == 0 || rotsAdaptive == true) {			/* Robust Tabu Search (RoTS) */
+				getFlippedVariablesStatus = rotsGetFlippedVariables(&(*flippedVariables), solverIterations, &(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList));
 			} else if (strcmp(algoName, "ilssa") == 0) {	/* ILS */
-				getFlippedVariablesStatus = ilssaGetFlippedVariables(&flippedVariables, solverIterations, &(*solution), &varList, &varScoreList, &clauseStatusList);
+				getFlippedVariablesStatus = ilssaGetFlippedVariables(&(*flippedVariables), solverIterations, &(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList));
 			} else {
 				pExit("No \"get flipped variable\" function for the solving alogrithm with the name \"%s\" not founded!\n", algoName);
 			}
 
+			PROFILE_STOP(PROFILE_PHASE_STEP);
+
 			
 			if (getFlippedVariablesStatus == 1) {			/* Variables flipped */
-				for (iFlippedVariables = 1; iFlippedVariables <= flippedVariables[0]; iFlippedVariables++) {	/* Loop over every flipped variable and flip the value in the solution. */
-					(*solution)[flippedVariables[iFlippedVariables]] = 1 - (*solution)[flippedVariables[iFlippedVariables]];
+				for (iFlippedVariables = 1; iFlippedVariables <= (*flippedVariables)[0]; iFlippedVariables++) {	/* Loop over every flipped variable and flip the value in the solution. */
+					assignmentNoteFlip((*flippedVariables)[iFlippedVariables], &(*solution));
+					(*solution)[(*flippedVariables)[iFlippedVariables]] = 1 - (*solution)[(*flippedVariables)[iFlippedVariables]];
 				}
 				
-				updateClauseStatusList(&flippedVariables, &(*solution), &varList, &clauseStatusList);
+				solverFlips = solverFlips + (*flippedVariables)[0];
+
+				PROFILE_START(PROFILE_PHASE_CLAUSES);
+				updateClauseStatusList(&(*flippedVariables), &(*solution), &(*varList), &(*clauseStatusList));
+				PROFILE_STOP(PROFILE_PHASE_CLAUSES);
+
+				if (clauseWeightList != NULL) {
+					weightedUpdateBest(&(*solution), &(*varList));	/* The weighted scores are already updated. */
+				} else if (ksatLength == 0) {
+					PROFILE_START(PROFILE_PHASE_SCORES);
+					updateVarScoreList(&(*solution), &(*varList), &(*varScoreList), &(*clauseStatusList));	/* The k-SAT kernels update the scores incrementally. */
+					PROFILE_STOP(PROFILE_PHASE_SCORES);
+				}
+
+				assignmentUpdateBest(&(*solution), &(*varList), &(*clauseStatusList));
 
-				updateVarScoreList(&(*solution), &varList, &varScoreList, &clauseStatusList);
+				if (traceReasonList != NULL)
+					traceFlips(&(*flippedVariables), (clauseWeightList != NULL ? weightedScoreList[0] : (*clauseStatusList)[0]));
 				
-				if (clauseStatusList[0] == 0)
+				if ((*clauseStatusList)[0] == 0)
 					break; /* Solution founded */
 			} else if (getFlippedVariablesStatus == -1) {	/* An restart is needed */
 				break;
 			}
+
+			if (stagnationRestarts == true && restartStagnation(solverIterations, (clauseWeightList != NULL ? weightedScoreList[0] : (*clauseStatusList)[0]), &(*varList)) == true)
+				break; /* The try stagnates */
+
 			solverIterations++;
+
+			if (checkpointRequest != 0)
+				checkpointHandleRequest(restartsCount, solverIterations, solverCutoff, &(*solution), &(*clauseList), &(*varList), &(*varScoreList), algoName);
+
+			if (PORTFOLIO_CANCELLED())
+				break; /* Another process of the portfolio found a model. */
 		}
 		
-		if (clauseStatusList[0] == 0)
+		if ((*clauseStatusList)[0] == 0)
 			break; /* Solution founded */
+
+		if (portfolioCancelled == true)
+			break;
 			
 		restartsCount++;
 	}
 
-	solutionQuality = clauseStatusList[0];
+	solverRestarts = restartsCount;
 
 
 	/* Clean up! */
-	if (strcmp(algoName, "rots") == 0) {			/* Robust Tabu Search (RoTS) */
-		//rotsCleanUp();
+	if (strcmp(algoName, "rots") == 0 || rotsAdaptive == true) {			/* Robust Tabu Search (RoTS) */
+		rotsCleanUp();
 	} else if (strcmp(algoName, "ilssa") == 0) {	/* ILS/SA */
-		//ilssaCleanUp();
+		ilssaCleanUp();
 	}
 
+	assignmentCleanUp();
+
+	ksatCleanUp();
+
+	multiflipCleanUp();
+
+	traceCleanUp();
+
 
-	clauseListCU = clauseList[0][0];
+	/* The weighted mode returns the best solution candidate which satisfies all hard clauses. */
+	if (clauseWeightList != NULL && weightedGetBest(&(*solution), &(*varList)) == true)
+		rebuildClauseStatusList(&(*solution), &(*clauseList), &(*clauseStatusList));
+
+
+	return (*clauseStatusList)[0];
+}
+
+
+/* solverCleanUp()
+ *
+ * Deallocate the memory of a formula which was loaded by
+ * readInstanceFile() or initialiseFormula(). The solution
+ * is kept, because it is returned to the caller. */
+void solverCleanUp(int ***clauseList, int ***varList, int **varScoreList, int **clauseStatusList, int **flippedVariables) {
+	unsigned int clauseListCU; 	/* Number of clauses for the clean-up loop. */
+	unsigned int iclauseListCU; 	/* Loop variable for the clauseList clean up. */
+	unsigned int varListCU; 	/* Number of variables for the clean-up loop. */
+	unsigned int iVarListCU; 	/* Loop variable for the varList clean up. */
+
+
+	clauseListCU = (*clauseList)[0][0];
 
 	for(iclauseListCU = 0; iclauseListCU <= clauseListCU; iclauseListCU++) 
-		free(clauseList[iclauseListCU]);
+		free((*clauseList)[iclauseListCU]);
 		
-	free(clauseList);
+	free(*clauseList);
 	
 
-	varListCU = varList[0][0];
+	varListCU = (*varList)[0][0];
 
 	for(iVarListCU = 0; iVarListCU <= varListCU; iVarListCU++)
-		free(varList[iVarListCU]);
+		free((*varList)[iVarListCU]);
 		
-	free(varList);
+	free(*varList);
 
 
-	free(varScoreList);
+	free(*varScoreList);
 
-	free(clauseStatusList);
+	free(*clauseStatusList);
 	
-	free(flippedVariables);
+	free(*flippedVariables);
+
+	free(fixedVariables);
+	fixedVariables = NULL;
+
+	weightedCleanUp();
+}
+
+
+/* solver()
+ *
+ * The is the main solving function. The idea is to
+ * encapsulate the functionality, which are used
+ * by all alogorithm.
+ * The solving process generate an random initial
+ * solution candidate. In each solver iteration step
+ * a "get flipped variable" function for the specific
+ * algorithm is called to retrieve a list of variables
+ * to flipp. Then the status of each clause (see
+ * clauseList variable description) and the score of
+ * each variable (see varScoreList variable description).
+ * The function returns the number of the unsatisfied
+ * clauses. */
+int solver(unsigned short **solution, char instanceFilePath[], char algoName[], unsigned int maxRestarts) {
+	/* This list contains all clauses with their literals. If
+	 * the literal has a negation, the variable is represented
+	 * as an negativ integer. The index 0 in the clause
+	 * (clauseList[x][0]) contains the number of literals in
+	 * this clause.
+	 * The index 0 (clauseList[0][0]) contains the total number
+	 * of clauses. */
+	int **clauseList;
+ 	
+	/* This list contains all variables mapped to the clause
+	 * number in which they occur (negative then the literal
+	 * has a negation, positive otherwise). The index 0 in the
+	 * variable (varList[x][0]) contains the total number of
+	 * clauses. The index 0 (varList[0][0]) contains the total
+	 * number of variables. */
+	int **varList;
+ 
+	/* This list contains the score (the number of clause 
+	 * satisfied [positiv] or unsatisfied [negative], if
+	 * this variable will be flipped in the next iteration step. */
+	int *varScoreList;
+
+	/* For each clause this list holds the number of true
+	 * literals. */
+	int *clauseStatusList;
+
+	int solutionQuality; 	/* Return value */
+	
+	int *flippedVariables;			/* The flipped variables selected by the algorithm. */
+	
+	
+	PROFILE_START(PROFILE_PHASE_LOAD);
+
+	readInstanceFile(instanceFilePath, &clauseList, &varList, &varScoreList, &(*solution), &clauseStatusList, &flippedVariables);
+
+	if (strcmp(algoName, "auto") == 0) {	/* The algorithm is selected by the features of the formula. */
+		featuresSelect(&clauseList, &varList, algoName);
+	}
+
+	if (reorderEnabled == true)
+		reorderFormula(&clauseList, &varList, &(*solution));
+
+	PROFILE_STOP(PROFILE_PHASE_LOAD);
+
+	solutionQuality = solverSearch(&(*solution), &clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables, algoName, maxRestarts, false);
+
+	reorderRestoreSolution(&(*solution));
+
+
+	/* Clean up! */
+	solverCleanUp(&clauseList, &varList, &varScoreList, &clauseStatusList, &flippedVariables);
+
+	reorderCleanUp();
 	
 	
 	return solutionQuality;
-}
+}
\ No newline at end of file
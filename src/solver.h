@@ -32,6 +32,19 @@
 #include "psat.h"
 #include "rots.h"
 #include "ilssa.h"
+#include "assignment.h"
+#include "weighted.h"
+#include "ksat.h"
+#include "parallel.h"
+#include "multiflip.h"
+#include "features.h"
+#include "reorder.h"
+#include "restart.h"
+#include "checkpoint.h"
+#include "profile.h"
+#include "trace.h"
+#include "portfolio.h"
+#include "output.h"
 
 
 #define S_INSTANCEFILE_LINE_MAXLENGTH 255 /* The maximum length of a line from the instance file. */
@@ -39,12 +52,47 @@
 #define S_RESTARTS_MAX 1000000000		  	/* The maximum number of possible restarts. */
 #define S_SOLVERITERATIONS_MAXFACTOR 10		/* This factor multiplied with the number of variables is the maximum number of solver iterations. */
 
+#define S_LIST_CAPACITY_MIN 4	/* The minimum capacity of a growing list (see listCapacity()). */
+
+
+extern unsigned short *fixedVariables;
+
+extern unsigned int solverRestarts;
+
+extern unsigned long long solverFlips;
+
+extern unsigned int solverNumVars;
+
 
 void updateVarScoreList(unsigned short **solution, int ***varList, int **varScoreList, int **clauseStatusList);
 
 void updateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList);
 
-int solver(unsigned short **solution, char instanceFilePath[], char algoName[]);
+unsigned int listCapacity(unsigned int size);
+
+void *growList(void *list, unsigned int oldSize, unsigned int newSize, size_t elementSize);
+
+void initialiseFormula(int ***clauseList, int ***varList, int **varScoreList, unsigned short **solution, int **clauseStatusList, int **flippedVariables);
+
+void addVariables(unsigned int numVars, int ***varList, int **varScoreList, unsigned short **solution, int **flippedVariables);
+
+int addClause(int literals[], int ***clauseList, int ***varList, unsigned short **solution, int **clauseStatusList);
+
+void fixVariable(int literal, int ***varList, unsigned short **solution, int **clauseStatusList, int **flippedVariables);
+
+void releaseVariables(int ***varList);
+
+bool normaliseClause(int literals[]);
+
+void readInstanceFile(char instanceFilePath[], int ***clauseList, int ***varList, int **varScoreList, unsigned short **solution, int **clauseStatusList, int **flippedVariables);
+
+void rebuildClauseStatusList(unsigned short **solution, int ***clauseList, int **clauseStatusList);
+
+int solverSearch(unsigned short **solution, int ***clauseList, int ***varList, int **varScoreList, int **clauseStatusList, int **flippedVariables, char algoName[], unsigned int maxRestarts, bool warmStart);
+
+void solverCleanUp(int ***clauseList, int ***varList, int **varScoreList, int **clauseStatusList, int **flippedVariables);
+
+int solver(unsigned short **solution, char instanceFilePath[], char algoName[], unsigned int maxRestarts);
 
 
 #endif /* SOLVER_H */
\ No newline at end of file
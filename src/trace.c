@@ -0,0 +1,264 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * trace.c
+ *	
+ * 	This file contains the recorder of the flip trace. The
+ *  search thread encodes each flip into a lock-free ring
+ *  buffer, which a writer thread flushes into the trace
+ *  file. The file starts with TRACE_MAGIC, followed by
+ *  records of unsigned (varint) and signed (zigzag varint)
+ *  numbers:
+ *  - a flip: the reason (1 byte, see TRACE_REASON_*), the
+ *    step since the last record, the variable minus the
+ *    last variable and the quality (the number of
+ *    unsatisfied clauses or the weighted cost) minus the
+ *    last quality.
+ *  - a restart: TRACE_REASON_RESTART (1 byte), the step
+ *    since the last record and the number of restarts.
+ *  The steps count the solver iterations with flips over
+ *  all tries, starting with 1. See tools/tracedecode.c for
+ *  the conversion into CSV.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "trace.h"
+
+
+/* External variables for the options: the trace file
+ * path (empty = no trace), every traceSample-th step is
+ * recorded and only the steps from traceWindowStart to
+ * traceWindowEnd. */
+char traceFilePath[TRACE_FILE_PATH_MAXLENGTH + 1] = "";
+unsigned int traceSample = 1;
+unsigned long long traceWindowStart = 0;
+unsigned long long traceWindowEnd = ULLONG_MAX;
+
+
+/* External variable for the reasons of the flipped
+ * variables (NULL if no trace is recorded). It has the
+ * same indices as the flippedVariables. */
+unsigned char *traceReasonList = NULL;
+
+
+/* External variables for the ring buffer. traceHead is
+ * the number of bytes written by the search thread,
+ * traceTail the number of bytes flushed by the writer
+ * thread. Each counter is only changed by one thread. */
+unsigned char traceBuffer[TRACE_BUFFER_SIZE];
+atomic_size_t traceHead = 0;
+atomic_size_t traceTail = 0;
+atomic_bool traceStop = false;
+
+
+/* External variables for the writer thread. */
+FILE *traceFileHandle = NULL;
+pthread_t traceWriter;
+
+
+/* External variables for the delta encoding: the step
+ * counter and the values of the last record. */
+unsigned long long traceStep = 0;
+unsigned long long traceLastStep = 0;
+int traceLastVar = 0;
+long long traceLastQuality = 0;
+
+
+/* traceWriterThread()
+ *
+ * Flushes the ring buffer into the trace file until the
+ * recorder is stopped and the buffer is empty. */
+void *traceWriterThread(void *argument) {
+	size_t head;		/* The current head. */
+	size_t tail;		/* The current tail. */
+	size_t length;		/* The length of the contiguous bytes. */
+	bool stop;			/* Was the recorder stopped before the head was read? */
+	struct timespec sleepTime = { 0, TRACE_WRITER_SLEEP };
+
+
+	while (true) {
+		stop = atomic_load_explicit(&traceStop, memory_order_acquire);
+		head = atomic_load_explicit(&traceHead, memory_order_acquire);
+		tail = atomic_load_explicit(&traceTail, memory_order_relaxed);
+
+		if (head == tail) {
+			if (stop == true)
+				break;
+
+			nanosleep(&sleepTime, NULL);
+			continue;
+		}
+
+		length = head - tail;
+		if ((tail & (TRACE_BUFFER_SIZE - 1)) + length > TRACE_BUFFER_SIZE)
+			length = TRACE_BUFFER_SIZE - (tail & (TRACE_BUFFER_SIZE - 1));
+
+		fwrite(&traceBuffer[tail & (TRACE_BUFFER_SIZE - 1)], 1, length, traceFileHandle);
+
+		atomic_store_explicit(&traceTail, tail + length, memory_order_release);
+	}
+
+	return NULL;
+}
+
+
+/* traceFinish()
+ *
+ * Stops the writer thread after the last record is
+ * flushed. It is called at the exit. */
+void traceFinish() {
+	if (traceFileHandle == NULL)
+		return;
+
+	atomic_store_explicit(&traceStop, true, memory_order_release);
+	pthread_join(traceWriter, NULL);
+
+	fclose(traceFileHandle);
+	traceFileHandle = NULL;
+}
+
+
+/* traceInitialisation()
+ *
+ * Initialisation of the recorder for a new search. The
+ * trace file and the writer thread are started with the
+ * first search. */
+void traceInitialisation(int ***varList) {
+	if (strlen(traceFilePath) == 0)
+		return;
+
+	if (traceFileHandle == NULL) {
+		traceFileHandle = fopen(traceFilePath, "wb");
+		if (traceFileHandle == NULL)
+			pExit("The trace file \"%s\" can't be written!\n", traceFilePath);
+
+		fwrite(TRACE_MAGIC, 1, strlen(TRACE_MAGIC), traceFileHandle);
+
+		if (pthread_create(&traceWriter, NULL, traceWriterThread, NULL) != 0)
+			pExit("The writer thread of the trace can't be started!\n");
+
+		atexit(traceFinish);
+	}
+
+	traceReasonList = calloc(((*varList)[0][0] + 1), sizeof(unsigned char));
+	if (traceReasonList == NULL)
+		perror("calloc() for traceReasonList failed");
+}
+
+
+/* traceEncodeUnsigned()
+ *
+ * Appends an unsigned number as varint (7 bits per byte,
+ * the high bit marks a following byte) to the record and
+ * returns the new length. */
+unsigned int traceEncodeUnsigned(unsigned char record[], unsigned int length, unsigned long long value) {
+	while (value >= 0x80) {
+		record[length++] = (unsigned char)(value | 0x80);
+		value = value >> 7;
+	}
+
+	record[length++] = (unsigned char)value;
+
+	return length;
+}
+
+
+/* traceEncodeSigned()
+ *
+ * Appends a signed number as zigzag varint (the sign is
+ * the lowest bit) to the record and returns the new
+ * length. */
+unsigned int traceEncodeSigned(unsigned char record[], unsigned int length, long long value) {
+	return traceEncodeUnsigned(record, length, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+
+/* traceWrite()
+ *
+ * Copies the record into the ring buffer. If the buffer is
+ * full, the search thread waits for the writer thread. */
+void traceWrite(unsigned char record[], unsigned int length) {
+	size_t head = atomic_load_explicit(&traceHead, memory_order_relaxed);	/* The current head. */
+	unsigned int iRecord;													/* Loop variable for the record. */
+
+
+	while (head + length - atomic_load_explicit(&traceTail, memory_order_acquire) > TRACE_BUFFER_SIZE)
+		sched_yield();
+
+	for (iRecord = 0; iRecord < length; iRecord++)
+		traceBuffer[(head + iRecord) & (TRACE_BUFFER_SIZE - 1)] = record[iRecord];
+
+	atomic_store_explicit(&traceHead, head + length, memory_order_release);
+}
+
+
+/* traceRestart()
+ *
+ * Records the start of a try. */
+void traceRestart(unsigned int restartsCount) {
+	unsigned char record[TRACE_RECORD_MAXLENGTH];	/* The encoded record. */
+	unsigned int length = 0;						/* The length of the record. */
+
+
+	record[length++] = TRACE_REASON_RESTART;
+	length = traceEncodeUnsigned(record, length, traceStep - traceLastStep);
+	length = traceEncodeUnsigned(record, length, restartsCount);
+
+	traceLastStep = traceStep;
+
+	traceWrite(record, length);
+}
+
+
+/* traceFlips()
+ *
+ * Records the flipped variables of a step and the quality
+ * after the step, if the step is sampled and in the
+ * window. */
+void traceFlips(int **flippedVariables, long long quality) {
+	unsigned char record[TRACE_RECORD_MAXLENGTH];	/* The encoded record. */
+	unsigned int length;							/* The length of the record. */
+	unsigned int iFlippedVariables;					/* Loop variable for the flippedVariables. */
+
+
+	traceStep++;
+
+	if (traceStep < traceWindowStart || traceStep > traceWindowEnd || traceStep % traceSample != 0)
+		return;
+
+	for (iFlippedVariables = 1; iFlippedVariables <= (*flippedVariables)[0]; iFlippedVariables++) {
+		length = 0;
+
+		record[length++] = traceReasonList[iFlippedVariables];
+		length = traceEncodeUnsigned(record, length, traceStep - traceLastStep);
+		length = traceEncodeSigned(record, length, (long long)(*flippedVariables)[iFlippedVariables] - traceLastVar);
+		length = traceEncodeSigned(record, length, quality - traceLastQuality);
+
+		traceLastStep = traceStep;
+		traceLastVar = (*flippedVariables)[iFlippedVariables];
+		traceLastQuality = quality;
+
+		traceWrite(record, length);
+	}
+}
+
+
+/* traceCleanUp()
+ *
+ * Deallocate memory which was used by the recorder for
+ * the search. The trace file is closed at the exit. */
+void traceCleanUp() {
+	free(traceReasonList);
+	traceReasonList = NULL;
+}
@@ -0,0 +1,79 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * trace.h
+ *
+ *    This is the header file for trace.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "solver.h"
+
+
+#define TRACE_FILE_PATH_MAXLENGTH 255		/* The maximum length of the trace file path. */
+#define TRACE_MAGIC "PSATTRC1"				/* The first bytes of a trace file. */
+#define TRACE_BUFFER_SIZE (1 << 20)			/* The size of the ring buffer in bytes (a power of two). */
+#define TRACE_RECORD_MAXLENGTH 32			/* The maximum length of an encoded record. */
+#define TRACE_WRITER_SLEEP 1000000			/* The nanoseconds the writer sleeps if the ring buffer is empty. */
+
+/* The reasons of a flip. The reason 0 marks the records
+ * of a restart. */
+#define TRACE_REASON_RESTART 0
+#define TRACE_REASON_BEST 1				/* The best candidate of the neighbourhood (an improvement for ILS/SA) */
+#define TRACE_REASON_ASPIRATION 2		/* The aspiration criterion of RoTS */
+#define TRACE_REASON_STAGNATION 3		/* The stagnation criterion of RoTS */
+#define TRACE_REASON_PERTURBATION 4		/* The perturbation of ILS/SA */
+#define TRACE_REASON_ACCEPTANCE 5		/* A non-improving candidate accepted by the simulated annealing */
+#define TRACE_REASON_MULTIFLIP 6		/* One of the independent improving variables of a multi-flip step */
+
+
+/* Notes the reason of the flipped variable with the
+ * index in the flippedVariables, if the trace is
+ * recorded. */
+#define TRACE_REASON(INDEX, REASON) do { if (traceReasonList != NULL) traceReasonList[INDEX] = REASON; } while (0)
+
+
+extern char traceFilePath[TRACE_FILE_PATH_MAXLENGTH + 1];
+
+extern unsigned int traceSample;
+
+extern unsigned long long traceWindowStart;
+
+extern unsigned long long traceWindowEnd;
+
+extern unsigned char *traceReasonList;
+
+
+void traceInitialisation(int ***varList);
+
+void traceRestart(unsigned int restartsCount);
+
+void traceFlips(int **flippedVariables, long long quality);
+
+void traceCleanUp();
+
+
+#endif /* TRACE_H */
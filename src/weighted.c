@@ -0,0 +1,311 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * weighted.c
+ *	
+ * 	This file contains the weighted partial MaxSAT mode for
+ *  instance files in the WCNF format. Instead of the number
+ *  of unsatisfied clauses, the sum of the weights of the
+ *  unsatisfied clauses is minimised. Hard clauses get a
+ *  weight higher then the sum of all soft clause weights.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+ 
+ 
+#include "weighted.h"
+
+
+/* External variable which is true if the instance
+ * file is in the WCNF format. */
+bool weightedMode = false;
+
+
+/* External variable for the clause weights.
+ * It contains for each clause its weight. The
+ * index 0 (clauseWeightList[0]) contains the
+ * weight of the hard clauses. It is NULL if the
+ * instance is not weighted. */
+long long *clauseWeightList = NULL;
+
+
+/* External variable for the weighted scores.
+ * It contains for each variable the weight of the
+ * clauses which become satisfied minus the weight
+ * of the clauses which become unsatisfied, if this
+ * variable will be flipped. The index 0
+ * (weightedScoreList[0]) contains the weight of all
+ * unsatisfied clauses. */
+long long *weightedScoreList = NULL;
+
+
+/* External variable for the clauseList of the
+ * weighted instance (see weightedRebuildScoreList()). */
+int **weightedClauseList;
+
+
+/* External variable for the best solution candidate
+ * which satisfies all hard clauses and its weight
+ * of the unsatisfied soft clauses (the cost).
+ * weightedBestCost is LLONG_MAX if there is no such
+ * solution candidate. */
+unsigned short *weightedBestSolution = NULL;
+long long weightedBestCost = LLONG_MAX;
+
+
+/* weightedAddClause()
+ *
+ * Sets the weight of the clause which was added last by
+ * addClause(). A weight equal to or higher then the top
+ * weight of the "p wcnf" line marks a hard clause. */
+void weightedAddClause(long long weight, int ***clauseList) {
+	clauseWeightList = growList(clauseWeightList, (*clauseList)[0][0], ((*clauseList)[0][0] + 1), sizeof(long long));
+
+	clauseWeightList[(*clauseList)[0][0]] = weight;
+}
+
+
+/* weightedInitialisation()
+ *
+ * Initialisation after all clauses are added. The weight of
+ * the hard clauses is set to the sum of all soft clause
+ * weights + 1, so a solution candidate with an unsatisfied
+ * hard clause is always worse then any solution candidate
+ * which satisfies all hard clauses. */
+void weightedInitialisation(long long top, int ***clauseList, int ***varList) {
+	unsigned int iClauseList;	/* Loop variable for the clauseList. */
+	long long softWeights = 0;	/* Sum of the soft clause weights. */
+
+
+	clauseWeightList = growList(clauseWeightList, ((*clauseList)[0][0] + 1), ((*clauseList)[0][0] + 1), sizeof(long long));
+
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++) {
+		if (clauseWeightList[iClauseList] < top)
+			softWeights = softWeights + clauseWeightList[iClauseList];
+	}
+
+	clauseWeightList[0] = softWeights + 1;
+
+	for (iClauseList = 1; iClauseList <= (*clauseList)[0][0]; iClauseList++) {
+		if (clauseWeightList[iClauseList] >= top)
+			clauseWeightList[iClauseList] = clauseWeightList[0];
+	}
+
+	weightedScoreList = calloc(((*varList)[0][0] + 1), sizeof(long long));
+	if (weightedScoreList == NULL)
+		perror("calloc() for weightedScoreList failed");
+
+	weightedBestSolution = calloc(((*varList)[0][0] + 1), sizeof(unsigned short));
+	if (weightedBestSolution == NULL)
+		perror("calloc() for weightedBestSolution failed");
+
+	weightedBestCost = clauseWeightList[0];
+}
+
+
+/* weightedTrueLiteralVar()
+ *
+ * Returns the variable of the first true literal in the
+ * clause, which is not a literal of the excluded variable,
+ * or 0 if there is no such literal. */
+unsigned int weightedTrueLiteralVar(int clause, unsigned int excludedVar, unsigned short **solution) {
+	unsigned int iClauseListLit;	/* Loop variable for the literals of the clause. */
+	int curLiteral;					/* Current literal of the loop. */
+	unsigned int var;				/* Variable of curLiteral. */
+
+
+	for (iClauseListLit = 1; iClauseListLit <= weightedClauseList[clause][0]; iClauseListLit++) {
+		curLiteral = weightedClauseList[clause][iClauseListLit];
+		var = (curLiteral > 0 ? curLiteral : (curLiteral * -1));
+
+		if (var != excludedVar && (*solution)[var] == (curLiteral > 0 ? 1 : 0))
+			return var;
+	}
+
+	return 0;
+}
+
+
+/* weightedRebuildScoreList()
+ *
+ * Determines the weightedScoreList from scratch for the
+ * solution candidate and its clauseStatusList. The
+ * clauseList is kept for the following updates by
+ * weightedUpdateClauseStatusList(). */
+void weightedRebuildScoreList(unsigned short **solution, int ***clauseList, int ***varList, int **clauseStatusList) {
+	unsigned int iClauseList;		/* Loop variable for the clauseList. */
+	unsigned int iClauseListLit;	/* Loop variable for the literals of a clause. */
+	int curLiteral;					/* Current literal of the loop. */
+
+
+	weightedClauseList = *clauseList;
+
+	memset(weightedScoreList, 0, ((*varList)[0][0] + 1) * sizeof(long long));
+
+	for (iClauseList = 1; iClauseList <= weightedClauseList[0][0]; iClauseList++) {
+		if ((*clauseStatusList)[iClauseList] == 0) {		/* A flip of every variable satisfies this clause. */
+			weightedScoreList[0] = weightedScoreList[0] + clauseWeightList[iClauseList];
+
+			for (iClauseListLit = 1; iClauseListLit <= weightedClauseList[iClauseList][0]; iClauseListLit++) {
+				curLiteral = weightedClauseList[iClauseList][iClauseListLit];
+				weightedScoreList[(curLiteral > 0 ? curLiteral : (curLiteral * -1))] += clauseWeightList[iClauseList];
+			}
+		} else if ((*clauseStatusList)[iClauseList] == 1) {	/* A flip of the only true literal unsatisfies this clause. */
+			weightedScoreList[weightedTrueLiteralVar(iClauseList, 0, &(*solution))] -= clauseWeightList[iClauseList];
+		}
+	}
+}
+
+
+/* weightedUpdateClauseStatusList()
+ *
+ * The weighted version of updateClauseStatusList(), which
+ * also updates the weightedScoreList. Only the clauses of
+ * the flipped variables whose number of true literals
+ * becomes 0, 1 or 2 change any score. */
+void weightedUpdateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList) {
+	unsigned int iFlippedVariables;	/* Loop variable for flippedVariables. */
+	unsigned int iVarListClause;	/* Loop variable for varList. */
+	unsigned int iClauseListLit;	/* Loop variable for the literals of a clause. */
+	unsigned int var;				/* Current flipped variable. */
+	unsigned short varValue;		/* Current variable status. */
+	int curClause;					/* Current selected clause in the iVarListClause loop. */
+	int curLiteral;					/* Current literal of a clause. */
+	unsigned int clause;			/* Number of curClause. */
+	long long weight;				/* Weight of curClause. */
+	int oldClauseStatus;			/* Number of true literals before the flip. */
+
+
+	/* The flipped variables are already flipped in the
+	 * solution. Revert them, so each variable can be
+	 * applied one after another. */
+	for (iFlippedVariables = 1; iFlippedVariables <= (*flippedVariables)[0]; iFlippedVariables++)
+		(*solution)[(*flippedVariables)[iFlippedVariables]] = 1 - (*solution)[(*flippedVariables)[iFlippedVariables]];
+
+	for (iFlippedVariables = 1; iFlippedVariables <= (*flippedVariables)[0]; iFlippedVariables++) {	/* Loop over every flipped variable. */
+		var = (*flippedVariables)[iFlippedVariables];
+		(*solution)[var] = 1 - (*solution)[var];
+		varValue = (*solution)[var];
+
+		for (iVarListClause = 1; iVarListClause <= (*varList)[var][0]; iVarListClause++) {	/* Loop over every clause which contains this variable. */
+			curClause = (*varList)[var][iVarListClause];
+			clause = (curClause > 0 ? curClause : (curClause * -1));
+			weight = clauseWeightList[clause];
+			oldClauseStatus = (*clauseStatusList)[clause];
+
+			if ((curClause > 0 && varValue == 1) || (curClause < 0 && varValue == 0)) {	/* After the variable flip, the literal is true. */
+				(*clauseStatusList)[clause] = oldClauseStatus + 1;
+
+				if (oldClauseStatus == 0) {			/* The clause becomes satisfied by this variable only. */
+					(*clauseStatusList)[0] = (*clauseStatusList)[0] - 1;
+					weightedScoreList[0] = weightedScoreList[0] - weight;
+
+					for (iClauseListLit = 1; iClauseListLit <= weightedClauseList[clause][0]; iClauseListLit++) {
+						curLiteral = weightedClauseList[clause][iClauseListLit];
+						weightedScoreList[(curLiteral > 0 ? curLiteral : (curLiteral * -1))] -= weight;
+					}
+
+					weightedScoreList[var] -= weight;
+				} else if (oldClauseStatus == 1) {	/* The other true literal can be flipped without unsatisfying the clause. */
+					weightedScoreList[weightedTrueLiteralVar(clause, var, &(*solution))] += weight;
+				}
+			} else {																	/* After the variable flip, the literal is false. */
+				(*clauseStatusList)[clause] = oldClauseStatus - 1;
+
+				if (oldClauseStatus == 1) {			/* The clause becomes unsatisfied. */
+					(*clauseStatusList)[0] = (*clauseStatusList)[0] + 1;
+					weightedScoreList[0] = weightedScoreList[0] + weight;
+
+					for (iClauseListLit = 1; iClauseListLit <= weightedClauseList[clause][0]; iClauseListLit++) {
+						curLiteral = weightedClauseList[clause][iClauseListLit];
+						weightedScoreList[(curLiteral > 0 ? curLiteral : (curLiteral * -1))] += weight;
+					}
+
+					weightedScoreList[var] += weight;
+				} else if (oldClauseStatus == 2) {	/* The remaining true literal can't be flipped without unsatisfying the clause. */
+					weightedScoreList[weightedTrueLiteralVar(clause, var, &(*solution))] -= weight;
+				}
+			}
+		}
+	}
+}
+
+
+/* weightedUpdateBest()
+ *
+ * Saves the solution candidate and prints its cost in an
+ * "o <cost>" line, if it satisfies all hard clauses and is
+ * better then the best solution candidate so far. */
+void weightedUpdateBest(unsigned short **solution, int ***varList) {
+	if (weightedScoreList[0] < weightedBestCost) {
+		memcpy(&weightedBestSolution[1], &(*solution)[1], (*varList)[0][0] * sizeof(unsigned short));
+
+		weightedBestCost = weightedScoreList[0];
+
+		printf("o %lld\n", weightedBestCost);
+		fflush(stdout);
+	}
+}
+
+
+/* weightedGetBest()
+ *
+ * Copies the best solution candidate which satisfies all
+ * hard clauses into the solution. It returns false if there
+ * is no such solution candidate. */
+bool weightedGetBest(unsigned short **solution, int ***varList) {
+	if (weightedBestCost >= clauseWeightList[0])
+		return false;
+
+	memcpy(&(*solution)[1], &weightedBestSolution[1], (*varList)[0][0] * sizeof(unsigned short));
+
+	return true;
+}
+
+
+/* weightedWriteCheckpoint()
+ *
+ * Writes the best solution candidate which satisfies all
+ * hard clauses into the checkpoint file. */
+void weightedWriteCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointWriteData(&weightedBestCost, sizeof(weightedBestCost), checkpointFileHandle);
+	checkpointWriteValues(weightedBestSolution, (*varList)[0][0], checkpointFileHandle);
+}
+
+
+/* weightedReadCheckpoint()
+ *
+ * Reads the best solution candidate which satisfies all
+ * hard clauses from the checkpoint file. */
+void weightedReadCheckpoint(FILE *checkpointFileHandle, int ***varList) {
+	checkpointReadData(&weightedBestCost, sizeof(weightedBestCost), checkpointFileHandle);
+	checkpointReadValues(weightedBestSolution, (*varList)[0][0], checkpointFileHandle);
+}
+
+
+/* weightedCleanUp()
+ *
+ * Deallocate memory which was used by the weighted mode.
+ * weightedBestCost is kept for the result output. */
+void weightedCleanUp() {
+	if (clauseWeightList != NULL && weightedBestCost >= clauseWeightList[0])
+		weightedBestCost = LLONG_MAX;
+
+	free(clauseWeightList);
+	clauseWeightList = NULL;
+
+	free(weightedScoreList);
+	weightedScoreList = NULL;
+
+	free(weightedBestSolution);
+	weightedBestSolution = NULL;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/* ############################################################# 
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * ############################################################# 
+ *
+ * weighted.h
+ *
+ *    This is the header file for weighted.c.
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#ifndef WEIGHTED_H
+#define WEIGHTED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "solver.h"
+
+
+extern bool weightedMode;
+
+extern long long *clauseWeightList;
+
+extern long long *weightedScoreList;
+
+extern long long weightedBestCost;
+
+
+void weightedAddClause(long long weight, int ***clauseList);
+
+void weightedInitialisation(long long top, int ***clauseList, int ***varList);
+
+void weightedRebuildScoreList(unsigned short **solution, int ***clauseList, int ***varList, int **clauseStatusList);
+
+void weightedUpdateClauseStatusList(int **flippedVariables, unsigned short **solution, int ***varList, int **clauseStatusList);
+
+void weightedUpdateBest(unsigned short **solution, int ***varList);
+
+bool weightedGetBest(unsigned short **solution, int ***varList);
+
+void weightedWriteCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
+void weightedReadCheckpoint(FILE *checkpointFileHandle, int ***varList);
+
+void weightedCleanUp();
+
+
+#endif /* WEIGHTED_H */
\ No newline at end of file
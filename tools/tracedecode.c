@@ -0,0 +1,144 @@
+/* #############################################################
+ * #                                                           #
+ * #                    pSAT - SLS SAT Solver                  #
+ * #                                                           #
+ * #############################################################
+ *
+ * tracedecode.c
+ *
+ * 	This file contains the decoder of the flip trace files
+ *  (see src/trace.c for the format). It prints one CSV
+ *  line for each flip with the step, the number of
+ *  restarts, the variable, the reason and the quality
+ *  after the step.
+ *
+ *  Usage: tracedecode <trace file>
+ *
+ *
+ * #############################################################
+ * #                                                           #
+ * #   Developed by                                            #
+ * #      Marcel Kliemannel <dev[at]marcel-kliemannel.de>      #
+ * #                                                           #
+ * #############################################################
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../src/trace.h"
+
+
+/* The names of the reasons (see TRACE_REASON_*). */
+char *tracedecodeReasons[] = { "restart", "best", "aspiration", "stagnation", "perturbation", "acceptance", "multiflip" };
+
+
+/* tracedecodeUnsigned()
+ *
+ * Reads an unsigned varint. Returns false at the end of
+ * the file. */
+bool tracedecodeUnsigned(FILE *traceFileHandle, unsigned long long *value) {
+	int curByte;			/* Current byte of the trace file. */
+	unsigned int shift = 0;	/* Position of the next 7 bits. */
+
+
+	*value = 0;
+
+	do {
+		curByte = fgetc(traceFileHandle);
+		if (curByte == EOF || shift > 63)
+			return false;
+
+		*value = *value | ((unsigned long long)(curByte & 0x7F) << shift);
+		shift = shift + 7;
+	} while ((curByte & 0x80) != 0);
+
+	return true;
+}
+
+
+/* tracedecodeSigned()
+ *
+ * Reads a signed zigzag varint. Returns false at the end
+ * of the file. */
+bool tracedecodeSigned(FILE *traceFileHandle, long long *value) {
+	unsigned long long zigzag;	/* The encoded value. */
+
+
+	if (tracedecodeUnsigned(traceFileHandle, &zigzag) == false)
+		return false;
+
+	*value = (long long)(zigzag >> 1) ^ -(long long)(zigzag & 1);
+
+	return true;
+}
+
+
+/* main()
+ *
+ * Decodes the trace file. */
+int main(int argc, char* argv[]) {
+	FILE *traceFileHandle;				/* File handle for the trace file. */
+	char magic[sizeof(TRACE_MAGIC)];	/* The first bytes of the file. */
+	int reason;							/* The reason of the current record. */
+	unsigned long long stepDelta;		/* The steps since the last record. */
+	unsigned long long restartsCount;	/* The number of restarts of a restart record. */
+	long long varDelta;					/* The variable minus the last variable. */
+	long long qualityDelta;				/* The quality minus the last quality. */
+
+	unsigned long long step = 0;		/* The current step. */
+	unsigned long long restarts = 0;	/* The current number of restarts. */
+	long long var = 0;					/* The current variable. */
+	long long quality = 0;				/* The current quality. */
+
+
+	if (argc != 2) {
+		printf("Usage: %s <trace file>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	traceFileHandle = fopen(argv[1], "rb");
+	if (traceFileHandle == NULL) {
+		printf("The trace file \"%s\" can't be opened!\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	memset(magic, 0, sizeof(magic));
+	if (fread(magic, 1, strlen(TRACE_MAGIC), traceFileHandle) != strlen(TRACE_MAGIC) || strcmp(magic, TRACE_MAGIC) != 0) {
+		printf("The file \"%s\" is no trace file!\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	printf("step,restarts,variable,reason,quality\n");
+
+	while ((reason = fgetc(traceFileHandle)) != EOF) {
+		if (reason == TRACE_REASON_RESTART) {
+			if (tracedecodeUnsigned(traceFileHandle, &stepDelta) == false || tracedecodeUnsigned(traceFileHandle, &restartsCount) == false)
+				break;
+
+			step = step + stepDelta;
+			restarts = restartsCount;
+			continue;
+		}
+
+		if (reason > TRACE_REASON_MULTIFLIP || tracedecodeUnsigned(traceFileHandle, &stepDelta) == false
+				|| tracedecodeSigned(traceFileHandle, &varDelta) == false || tracedecodeSigned(traceFileHandle, &qualityDelta) == false)
+			break;
+
+		step = step + stepDelta;
+		var = var + varDelta;
+		quality = quality + qualityDelta;
+
+		printf("%llu,%llu,%lld,%s,%lld\n", step, restarts, var, tracedecodeReasons[reason], quality);
+	}
+
+	if (reason != EOF)
+		fprintf(stderr, "The trace file \"%s\" is truncated or damaged.\n", argv[1]);
+
+	fclose(traceFileHandle);
+
+	return EXIT_SUCCESS;
+}